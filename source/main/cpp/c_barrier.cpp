@@ -0,0 +1,36 @@
+#include "ccore/c_target.h"
+
+#include "catomic/c_barrier.h"
+
+#if defined(TARGET_LINUX)
+	#include <linux/membarrier.h>
+#endif
+
+namespace ncore
+{
+	namespace barrier
+	{
+#if defined(TARGET_LINUX)
+		namespace cpu_membarrier
+		{
+			// The private expedited command (4.14+) interrupts only the cpus running
+			// this process, it has to be registered once before the first use. The
+			// global command (4.3+) waits for every cpu to pass through the scheduler,
+			// which is slow but still correct.
+			static int		sSelect()
+			{
+				long const mask = sCall(MEMBARRIER_CMD_QUERY);
+				if (mask <= 0)
+					return 0;
+				if ((mask & MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0 && sCall(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED) == 0)
+					return MEMBARRIER_CMD_PRIVATE_EXPEDITED;
+				if ((mask & MEMBARRIER_CMD_GLOBAL) != 0)
+					return MEMBARRIER_CMD_GLOBAL;
+				return 0;
+			}
+
+			int const		gCommand = sSelect();
+		}
+#endif
+	} // namespace barrier
+} // namespace ncore
@@ -63,11 +63,11 @@ namespace ncore
 			{
 				_allocator = allocator;
 
-				void * head_mem = allocate_object<mempool>(allocator);				// new mempool(sizeof(head), size * factor);
+				void * head_mem = allocate_object<mempool>(allocator, DCORE_CACHELINE_SIZE);				// new mempool(sizeof(head), size * factor);
 				_head = new (head_mem) mempool();
 				_head->init(allocator, sizeof(head), size * factor);
 
-				void * data_mem = allocate_object<mempool>(allocator);				// new mempool(data_size, size);
+				void * data_mem = allocate_object<mempool>(allocator, DCORE_CACHELINE_SIZE);				// new mempool(data_size, size);
 				_data   = new (data_mem) mempool();
 				_data->init(allocator, data_size, size);
 
@@ -83,11 +83,11 @@ namespace ncore
 
 				u32 size = bsize / data_size;
 
-				void * head_mem = allocate_object<mempool>(allocator);				// new mempool(sizeof(head), size * factor);
+				void * head_mem = allocate_object<mempool>(allocator, DCORE_CACHELINE_SIZE);				// new mempool(sizeof(head), size * factor);
 				_head = new (head_mem) mempool();
 				_head->init(allocator, sizeof(head), size * factor);
 
-				void * data_mem = allocate_object<mempool>(allocator);				// new mempool(data_size, buf, size);
+				void * data_mem = allocate_object<mempool>(allocator, DCORE_CACHELINE_SIZE);				// new mempool(data_size, buf, size);
 				_data   = new (data_mem) mempool();
 				_data->init(allocator, data_size, buf, size);
 
@@ -101,7 +101,7 @@ namespace ncore
 			{
 				_allocator = allocator;
 
-				void * head_mem = allocate_object<mempool>(allocator);				// new mempool(sizeof(head), mp->size() * factor);
+				void * head_mem = allocate_object<mempool>(allocator, DCORE_CACHELINE_SIZE);				// new mempool(sizeof(head), mp->size() * factor);
 				_head = new (head_mem) mempool();
 				_head->init(allocator, sizeof(head), mp->max_size() * factor);
 
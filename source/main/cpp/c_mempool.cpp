@@ -15,6 +15,7 @@ namespace ncore
 			mBuffer = NULL;
 			mCsize = 0;
 			mExtern = false;
+			mTrackHighWater = false;
 		}
 
 		bool mempool::init(alloc_t* allocator, u32 mempool_esize, u32 size)
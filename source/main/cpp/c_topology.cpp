@@ -0,0 +1,248 @@
+#include "ccore/c_target.h"
+
+#include "catomic/c_topology.h"
+
+#if defined(TARGET_LINUX)
+	#include <stdio.h>
+#elif defined(TARGET_PC)
+	#include <windows.h>
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		topology const&	topology::sGet()
+		{
+			static topology const t;
+			return t;
+		}
+
+		topology::topology()
+		{
+			// Every cpu on its own until the OS tells otherwise, 'mGroup' holds the
+			// lowest cpu of a group (the node number for LEVEL_NODE) until number_groups()
+			mNumCpus = cpu_current::sCount();
+			for (u32 c = 0; c < D_TOPOLOGY_MAX_CPUS; ++c)
+			{
+				mGroup[LEVEL_CORE][c] = (u16)c;
+				mGroup[LEVEL_L2][c] = (u16)c;
+				mGroup[LEVEL_L3][c] = (u16)c;
+				mGroup[LEVEL_NODE][c] = 0;
+			}
+			detect();
+			if (mNumCpus == 0)
+				mNumCpus = 1;
+			number_groups();
+		}
+
+		void		topology::number_groups()
+		{
+			u32 const n = mNumCpus < D_TOPOLOGY_MAX_CPUS ? mNumCpus : D_TOPOLOGY_MAX_CPUS;
+			u16 renumber[D_TOPOLOGY_MAX_CPUS];
+			for (u32 l = 0; l < LEVEL_COUNT; ++l)
+			{
+				for (u32 i = 0; i < D_TOPOLOGY_MAX_CPUS; ++i)
+					renumber[i] = 0xffff;
+				u32 groups = 0;
+				for (u32 c = 0; c < n; ++c)
+				{
+					u32 const key = mGroup[l][c] % D_TOPOLOGY_MAX_CPUS;
+					if (renumber[key] == 0xffff)
+						renumber[key] = (u16)groups++;
+					mGroup[l][c] = renumber[key];
+				}
+				mNumGroups[l] = groups;
+			}
+		}
+
+		u32			topology::neighbours(u32 cpu, u32* cpus, u32 max) const
+		{
+			u32 n = 0;
+			for (u32 d = DISTANCE_CORE; d <= DISTANCE_REMOTE; ++d)
+			{
+				for (u32 c = 0; c < mNumCpus && n < max; ++c)
+				{
+					if (distance(cpu, c) == d)
+						cpus[n++] = c;
+				}
+			}
+			return n;
+		}
+
+#if defined(TARGET_LINUX)
+
+		// Read the first line of a sysfs file
+		static bool		sReadFile(const char* path, char* buf, u32 size)
+		{
+			FILE* f = fopen(path, "r");
+			if (f == NULL)
+				return false;
+			bool const ok = fgets(buf, (int)size, f) != NULL;
+			fclose(f);
+			return ok;
+		}
+
+		static u32		sParseNumber(const char*& s)
+		{
+			u32 v = 0;
+			while (*s >= '0' && *s <= '9')
+				v = v * 10 + (u32)(*s++ - '0');
+			return v;
+		}
+
+		// Parse a cpu list like "0-3,8,10-11", set 'out' to 'value' for every cpu
+		// in it when 'out' is not NULL.
+		// @return the highest cpu in the list + 1, 0 when the list is empty
+		static u32		sParseList(const char* s, u16* out, u16 value)
+		{
+			u32 end = 0;
+			while (*s >= '0' && *s <= '9')
+			{
+				u32 const first = sParseNumber(s);
+				u32 last = first;
+				if (*s == '-')
+				{
+					++s;
+					last = sParseNumber(s);
+				}
+				for (u32 c = first; out != NULL && c <= last && c < D_TOPOLOGY_MAX_CPUS; ++c)
+					out[c] = value;
+				if (last + 1 > end)
+					end = last + 1;
+				if (*s != ',')
+					break;
+				++s;
+			}
+			return end;
+		}
+
+		// The first cpu of a sysfs cpu list, the lists are sorted
+		static bool		sReadFirst(const char* path, u32& cpu)
+		{
+			char buf[64];
+			if (!sReadFile(path, buf, sizeof(buf)) || buf[0] < '0' || buf[0] > '9')
+				return false;
+			const char* s = buf;
+			cpu = sParseNumber(s);
+			return true;
+		}
+
+		void		topology::detect()
+		{
+			// Lists can be long on large machines, only node cpu lists are read in full
+			char buf[4096];
+			char path[128];
+
+			if (sReadFile("/sys/devices/system/cpu/possible", buf, sizeof(buf)))
+			{
+				u32 const n = sParseList(buf, NULL, 0);
+				if (n > 0)
+					mNumCpus = n;
+			}
+
+			u32 const n = mNumCpus < D_TOPOLOGY_MAX_CPUS ? mNumCpus : D_TOPOLOGY_MAX_CPUS;
+			for (u32 c = 0; c < n; ++c)
+			{
+				u32 first;
+				snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", c);
+				if (sReadFirst(path, first))
+					mGroup[LEVEL_CORE][c] = (u16)first;
+
+				for (u32 i = 0; ; ++i)
+				{
+					snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/level", c, i);
+					u32 level;
+					if (!sReadFirst(path, level))
+						break;
+					snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", c, i);
+					if (!sReadFile(path, buf, sizeof(buf)) || buf[0] == 'I')
+						continue;
+					snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", c, i);
+					if ((level == 2 || level == 3) && sReadFirst(path, first))
+						mGroup[level == 2 ? LEVEL_L2 : LEVEL_L3][c] = (u16)first;
+				}
+			}
+
+			// Only the node ids in the list are set, the others have to read as absent
+			u16 nodes[D_TOPOLOGY_MAX_CPUS];
+			for (u32 i = 0; i < D_TOPOLOGY_MAX_CPUS; ++i)
+				nodes[i] = 0;
+			if (!sReadFile("/sys/devices/system/node/possible", buf, sizeof(buf)))
+				return;
+			u32 const num_nodes = sParseList(buf, nodes, 1);
+			for (u32 node = 0; node < num_nodes && node < D_TOPOLOGY_MAX_CPUS; ++node)
+			{
+				if (nodes[node] != 1)
+					continue;
+				snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+				if (sReadFile(path, buf, sizeof(buf)))
+					sParseList(buf, mGroup[LEVEL_NODE], (u16)node);
+			}
+		}
+
+#elif defined(TARGET_PC)
+
+		// Records are only taken from processor group 0, at most 64 cpus
+		static u32		sLowestCpu(ULONG_PTR mask)
+		{
+			u32 c = 0;
+			while ((mask & 1) == 0)
+			{
+				mask >>= 1;
+				++c;
+			}
+			return c;
+		}
+
+		void		topology::detect()
+		{
+			SYSTEM_LOGICAL_PROCESSOR_INFORMATION info[256];
+			DWORD size = sizeof(info);
+			if (!GetLogicalProcessorInformation(info, &size))
+				return;
+
+			u32 const count = (u32)(size / sizeof(info[0]));
+			for (u32 i = 0; i < count; ++i)
+			{
+				ULONG_PTR const mask = info[i].ProcessorMask;
+				if (mask == 0)
+					continue;
+
+				u32 level;
+				u16 key = (u16)sLowestCpu(mask);
+				switch (info[i].Relationship)
+				{
+				case RelationProcessorCore:
+					level = LEVEL_CORE;
+					break;
+				case RelationCache:
+					if (info[i].Cache.Type == CacheInstruction || (info[i].Cache.Level != 2 && info[i].Cache.Level != 3))
+						continue;
+					level = info[i].Cache.Level == 2 ? LEVEL_L2 : LEVEL_L3;
+					break;
+				case RelationNumaNode:
+					level = LEVEL_NODE;
+					key = (u16)info[i].NumaNode.NodeNumber;
+					break;
+				default:
+					continue;
+				}
+
+				for (u32 c = 0; c < sizeof(ULONG_PTR) * 8 && c < D_TOPOLOGY_MAX_CPUS; ++c)
+				{
+					if ((mask >> c) & 1)
+						mGroup[level][c] = key;
+				}
+			}
+		}
+
+#else
+
+		void		topology::detect()
+		{
+		}
+
+#endif
+	}
+}
@@ -5,6 +5,10 @@
 #pragma once 
 #endif
 
+#include "catomic/private/c_compiler.h"
+
+#include <string.h>
+
 namespace ncore
 {
 	class alloc_t;
@@ -14,10 +18,15 @@ namespace ncore
 		//-------------------------------------------------------------------------------------
 		// atomic integers, forward declare
 		//-------------------------------------------------------------------------------------
+		class atom_s8;
+		class atom_u8;
+		class atom_s16;
+		class atom_u16;
 		class atom_s32;
 		class atom_u32;
 		class atom_s64;
 		class atom_u64;
+		class atom_u128;
 
 		//-------------------------------------------------------------------------------------
 		// atomic read32/write32, read64/write64, and cas32/cas64 functions
@@ -42,9 +51,72 @@ namespace ncore
 		static bool		cas_u64(u64 volatile* mem, u64 old, u64 n);
 		static bool		cas_u64(u64 volatile* mem, u32 ol, u32 oh, u32 nl, u32 nh);
 
+		//-------------------------------------------------------------------------------------
+		// memory order variants of read, write and cas
+		// read_* and cas_* are sequentially consistent, write_* is a release store.
+		// relaxed only guarantees atomicity, acquire keeps later accesses from moving
+		// before the load, release keeps earlier accesses from moving after the store.
+		//-------------------------------------------------------------------------------------
+		static s32		read_s32_relaxed(s32 volatile* p);
+		static s32		read_s32_acquire(s32 volatile* p);
+		static void		write_s32_relaxed(s32 volatile* p, s32 v);
+		static void		write_s32_release(s32 volatile* p, s32 v);
+		static bool		cas_s32_relaxed(s32 volatile* mem, s32 old, s32 n);
+		static bool		cas_s32_acquire(s32 volatile* mem, s32 old, s32 n);
+		static bool		cas_s32_release(s32 volatile* mem, s32 old, s32 n);
+		static bool		cas_s32_acq_rel(s32 volatile* mem, s32 old, s32 n);
+
+		static u32		read_u32_relaxed(u32 volatile* p);
+		static u32		read_u32_acquire(u32 volatile* p);
+		static void		write_u32_relaxed(u32 volatile* p, u32 v);
+		static void		write_u32_release(u32 volatile* p, u32 v);
+		static bool		cas_u32_relaxed(u32 volatile* mem, u32 old, u32 n);
+		static bool		cas_u32_acquire(u32 volatile* mem, u32 old, u32 n);
+		static bool		cas_u32_release(u32 volatile* mem, u32 old, u32 n);
+		static bool		cas_u32_acq_rel(u32 volatile* mem, u32 old, u32 n);
+
+		static s64		read_s64_relaxed(s64 volatile* p);
+		static s64		read_s64_acquire(s64 volatile* p);
+		static void		write_s64_relaxed(s64 volatile* p, s64 v);
+		static void		write_s64_release(s64 volatile* p, s64 v);
+		static bool		cas_s64_relaxed(s64 volatile* mem, s64 old, s64 n);
+		static bool		cas_s64_acquire(s64 volatile* mem, s64 old, s64 n);
+		static bool		cas_s64_release(s64 volatile* mem, s64 old, s64 n);
+		static bool		cas_s64_acq_rel(s64 volatile* mem, s64 old, s64 n);
+
+		static u64		read_u64_relaxed(u64 volatile* p);
+		static u64		read_u64_acquire(u64 volatile* p);
+		static void		write_u64_relaxed(u64 volatile* p, u64 v);
+		static void		write_u64_release(u64 volatile* p, u64 v);
+		static bool		cas_u64_relaxed(u64 volatile* mem, u64 old, u64 n);
+		static bool		cas_u64_acquire(u64 volatile* mem, u64 old, u64 n);
+		static bool		cas_u64_release(u64 volatile* mem, u64 old, u64 n);
+		static bool		cas_u64_acq_rel(u64 volatile* mem, u64 old, u64 n);
+
+		//-------------------------------------------------------------------------------------
+		// atomic read128/write128 and cas128 functions, 64 bit cpu only (cmpxchg16b)
+		// Wide enough to hold a full pointer next to a 64 bit ABA tag. The memory operand
+		// has to be 16 byte aligned. There is no plain 128 bit load on x86, read_u128 is
+		// a locked cmpxchg16b and write_u128 a cmpxchg16b loop, so use them sparingly.
+		//-------------------------------------------------------------------------------------
+		struct force_align(16) u128
+		{
+			u64			lo;
+			u64			hi;
+		};
+
+		static u128		read_u128(u128 volatile* p);
+		static void		write_u128(u128 volatile* p, u128 v);
+		static bool		cas_u128(u128 volatile* mem, u128 old, u128 n);
+		static bool		cas_u128(u128 volatile* mem, u64 ol, u64 oh, u64 nl, u64 nh);
+		static bool		compare_exchange_u128(u128 volatile* mem, u128& expected, u128 n);
+
 
 		//-------------------------------------------------------------------------------------
 		// atomic integer public base
+		// Implemented for 8, 16, 32 and 64 bit integers, the 8 and 16 bit types are for
+		// dense arrays of per slot state. Keep in mind that neighbouring small atomics
+		// share a cache line, so they only pack well when they are not hot.
 		//-------------------------------------------------------------------------------------
 		template<class T>
 		class atom_int_type
@@ -59,8 +131,37 @@ namespace ncore
 			T			get() const;
 			void		set(T v);
 
+			// Explicit memory order variants, get() and cas() are sequentially
+			// consistent and set() is a release store.
+			T			load_relaxed() const;
+			T			load_acquire() const;
+			void		store_relaxed(T v);
+			void		store_release(T v);
+
+			bool		cas(T old, T n);
+			bool		cas_relaxed(T old, T n);
+			bool		cas_acquire(T old, T n);
+			bool		cas_release(T old, T n);
+			bool		cas_acq_rel(T old, T n);
+
+			// Sequentially consistent cas, on failure 'expected' receives the value it found
+			bool		compare_exchange(T& expected, T n);
+
 			T			swap(T i);
 
+			// Read-modify-write, returning the value held before the operation
+			T			exchange(T i);
+			T			fetch_add(T i);
+			T			fetch_sub(T i);
+			T			fetch_or(T i);
+			T			fetch_and(T i);
+
+			// Store the smaller/larger of the current value and i, returning the value
+			// held before. No locked instruction is issued when the stored value
+			// already dominates, which is the common case for high-water marks.
+			T			fetch_min(T i);
+			T			fetch_max(T i);
+
 			void		incr();
 			void		decr();
 
@@ -82,19 +183,69 @@ namespace ncore
 			bool		bit_test_clr(u32 n);
 			bool		bit_test_chg(u32 n);
 
+			// Blocking wait and notify, only for the 32 bit types (futex, WaitOnAddress).
+			// wait() sleeps until the value is no longer 'expected', wait_for() gives up
+			// after 'timeout_ns' and returns false. notify_*() wake threads sleeping in
+			// wait(), call them after changing the value.
+			void		wait(T expected) const;
+			bool		wait_for(T expected, u64 timeout_ns) const;
+			void		notify_one();
+			void		notify_all();
+
 						atom_int_type();
 						atom_int_type(const atom_int_type& i);
 						atom_int_type(T i);
 		};
+
+		//-------------------------------------------------------------------------------------
+		// atomic 128 bit value, e.g. a pointer and a tag in one word
+		//-------------------------------------------------------------------------------------
+		class atom_u128
+		{
+		protected:
+			volatile u128	_data;
+
+		public:
+			u128		get() const												{ return read_u128((u128 volatile*)&_data); }
+			void		set(u128 v)												{ write_u128(&_data, v); }
+
+			u128		swap(u128 v)
+			{
+				u128 old = get();
+				while (!cas_u128(&_data, old, v))
+					old = get();
+				return old;
+			}
+
+			bool		cas(u128 old, u128 n)									{ return cas_u128(&_data, old, n); }
+			bool		cas(u64 ol, u64 oh, u64 nl, u64 nh)						{ return cas_u128(&_data, ol, oh, nl, nh); }
+			bool		compare_exchange(u128& expected, u128 n)				{ return compare_exchange_u128(&_data, expected, n); }
+
+						atom_u128()												{ _data.lo = 0; _data.hi = 0; }
+						atom_u128(u64 lo, u64 hi)								{ _data.lo = lo; _data.hi = hi; }
+						atom_u128(const atom_u128& i)							{ set(i.get()); }
+		};
 	}
 }
 
-#if defined(TARGET_PC)
+#if defined(D_ATOMIC_STD)
+	#include "catomic/private/c_atomic_std.h"
+#elif defined(TARGET_PC)
 	#if defined(TARGET_32BIT)
 		#include "catomic/private/c_atomic_x86_win32.h"
 	#else
 		#include "catomic/private/c_atomic_x86_win64.h"
 	#endif
+#elif defined(TARGET_LINUX)
+	#if defined(__x86_64__)
+		#include "catomic/private/c_atomic_x86_linux64.h"
+	#elif defined(__aarch64__) && defined(D_ATOMIC_ARM64)
+		// Not run on AArch64 hardware or qemu yet, opt in with D_ATOMIC_ARM64,
+		// other AArch64 builds define D_ATOMIC_STD
+		#include "catomic/private/c_atomic_arm64.h"
+	#else
+		#error Unsupported CPU
+	#endif
 #elif defined(TARGET_360)
 	#include "catomic/private/c_atomic_ppc_360.h"
 #elif defined(TARGET_PS3)
@@ -107,6 +258,298 @@ namespace ncore
 	#error Unsupported CPU
 #endif
 
+#if defined(TARGET_LINUX)
+	#include "catomic/private/c_wait_linux.h"
+#elif defined(TARGET_PC)
+	#include "catomic/private/c_wait_win.h"
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		//-------------------------------------------------------------------------------------
+		// atomic integer functions shared by all backends
+		// No cpu has a min/max that returns early, so they are a relaxed check
+		// followed by a cas loop.
+		//-------------------------------------------------------------------------------------
+		template <class T>
+		inline T		atom_int_type<T>::fetch_min(T i)
+		{
+			T old = load_relaxed();
+			while (i < old)
+			{
+				if (cas(old, i))
+					return old;
+				old = load_relaxed();
+			}
+			return old;
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_max(T i)
+		{
+			T old = load_relaxed();
+			while (i > old)
+			{
+				if (cas(old, i))
+					return old;
+				old = load_relaxed();
+			}
+			return old;
+		}
+
+		//-------------------------------------------------------------------------------------
+		// atomic value of any trivially copyable type of 1, 2, 4, 8 or 16 bytes
+		// The value is kept in the native word of the same size (atom_u8 up to
+		// atom_u128) and copied in and out bit for bit, so a struct of several fields
+		// is updated with a single cas. Other sizes do not compile.
+		// Padding bytes take part in the comparison, so zero them or avoid padding.
+		//-------------------------------------------------------------------------------------
+		template <u32 N> struct atom_word;
+		template <> struct atom_word<1>		{ typedef u8	value; typedef atom_u8		type; };
+		template <> struct atom_word<2>		{ typedef u16	value; typedef atom_u16		type; };
+		template <> struct atom_word<4>		{ typedef u32	value; typedef atom_u32		type; };
+		template <> struct atom_word<8>		{ typedef u64	value; typedef atom_u64		type; };
+		template <> struct atom_word<16>	{ typedef u128	value; typedef atom_u128	type; };
+
+		template <class T>
+		class atom
+		{
+		public:
+			typedef typename atom_word<sizeof(T)>::value	word_t;
+			typedef typename atom_word<sizeof(T)>::type		atom_t;
+			typedef char	check_trivially_copyable[__is_trivially_copyable(T) ? 1 : -1];
+
+			T			load() const											{ return from_word(_data.get()); }
+			void		store(T v)												{ _data.set(to_word(v)); }
+			T			exchange(T v)											{ return from_word(_data.swap(to_word(v))); }
+
+			/**
+			* Replace the value with 'desired' when it equals 'expected'.
+			* On failure 'expected' receives the value the cas found.
+			*/
+			bool		compare_exchange(T& expected, T desired)
+			{
+				word_t w = to_word(expected);
+				if (_data.compare_exchange(w, to_word(desired)))
+					return true;
+				expected = from_word(w);
+				return false;
+			}
+
+						atom()													{ }
+						atom(T v)												{ store(v); }
+						atom(const atom& v)										{ store(v.load()); }
+
+		protected:
+			static word_t	to_word(T const& v)									{ word_t w; memcpy(&w, &v, sizeof(w)); return w; }
+			static T		from_word(word_t const& w)							{ T v; memcpy(&v, &w, sizeof(v)); return v; }
+
+			atom_t		_data;
+		};
+
+		//-------------------------------------------------------------------------------------
+		// atomic flag, a single byte that is either set or clear
+		// test_and_set() acquires and clear() releases, so it can guard a slot.
+		//-------------------------------------------------------------------------------------
+		class atom_flag
+		{
+		public:
+			/**
+			* Set the flag.
+			* @return true if it was already set
+			*/
+			bool		test_and_set()											{ return _flag.exchange(1) != 0; }
+			void		clear()													{ _flag.store_release(0); }
+			bool		test() const											{ return _flag.load_acquire() != 0; }
+
+						atom_flag()												{ }
+
+		protected:
+			atom_u8		_flag;
+		};
+
+		//-------------------------------------------------------------------------------------
+		// atomic floating point, for sums and extremes aggregated by many threads
+		// Arithmetic is a cas loop on the bit pattern held in atom_u32/atom_u64, so the
+		// compare is exact (-0.0 and 0.0 differ, a stored NaN still matches itself).
+		// fetch_min/fetch_max ignore a NaN argument and do not write when the stored
+		// value already dominates.
+		//-------------------------------------------------------------------------------------
+		template <class F>
+		class atom_float : public atom<F>
+		{
+			typedef atom<F>					base;
+			typedef typename base::word_t	word_t;
+
+		public:
+			// Read-modify-write, returning the value held before the operation
+			F			fetch_add(F v)
+			{
+				word_t old = this->_data.load_relaxed();
+				for (;;)
+				{
+					F const cur = base::from_word(old);
+					if (this->_data.cas(old, base::to_word(cur + v)))
+						return cur;
+					old = this->_data.load_relaxed();
+				}
+			}
+			F			fetch_sub(F v)											{ return fetch_add(-v); }
+
+			F			fetch_min(F v)
+			{
+				word_t old = this->_data.load_relaxed();
+				F cur = base::from_word(old);
+				while (v < cur)
+				{
+					if (this->_data.cas(old, base::to_word(v)))
+						return cur;
+					old = this->_data.load_relaxed();
+					cur = base::from_word(old);
+				}
+				return cur;
+			}
+
+			F			fetch_max(F v)
+			{
+				word_t old = this->_data.load_relaxed();
+				F cur = base::from_word(old);
+				while (v > cur)
+				{
+					if (this->_data.cas(old, base::to_word(v)))
+						return cur;
+					old = this->_data.load_relaxed();
+					cur = base::from_word(old);
+				}
+				return cur;
+			}
+
+			void		add(F v)												{ fetch_add(v); }
+			void		sub(F v)												{ fetch_add(-v); }
+
+						atom_float() : base((F)0)								{ }
+						atom_float(F v) : base(v)								{ }
+						atom_float(const atom_float& v) : base(v.load())		{ }
+		};
+
+		typedef atom_float<f32>		atom_f32;
+		typedef atom_float<f64>		atom_f64;
+
+		//-------------------------------------------------------------------------------------
+		// atomic on its own cache line
+		// Wraps any of the atom types, e.g. atom_padded<atom_u32>, so that two of them
+		// written by different threads never share a cache line.
+		//-------------------------------------------------------------------------------------
+		template <class T>
+		class DCORE_CACHELINE_ALIGN atom_padded : public T
+		{
+		public:
+						atom_padded() : T()										{ }
+			template <class V>
+						atom_padded(V v) : T(v)									{ }
+		};
+
+		//-------------------------------------------------------------------------------------
+		// atomic pointer with a version tag against ABA
+		// Every store, exchange and successful cas increments the tag, so a cas against a
+		// stale (pointer, tag) pair fails even when the pointer was recycled in between.
+		// x86-64:         48 bit pointer and 16 bit tag packed in one u64 (canonical user
+		//                 space addresses), define D_ATOMIC_PTR_WIDE to use a 128 bit cas.
+		// other 64 bit:   pointer and 64 bit tag in a 128 bit cas, the top byte of an
+		//                 AArch64 pointer may carry a hardware tag so it is not reused.
+		// 32 bit:         pointer and 32 bit tag in a u64.
+		//-------------------------------------------------------------------------------------
+		template <class T>
+		class atom_ptr
+		{
+		public:
+			T*			load() const											{ u64 t; return load(t); }
+
+			/**
+			* Load pointer and tag in one atomic read, pass both to cas().
+			*/
+			T*			load(u64& tag) const;
+
+			void		store(T* p)												{ exchange(p); }
+
+			T*			exchange(T* p)
+			{
+				u64 t;
+				T* o = load(t);
+				while (!cas(o, t, p))
+					o = load(t);
+				return o;
+			}
+
+			/**
+			* Replace 'old' with 'n' when both the pointer and the tag still match.
+			*/
+			bool		cas(T* old, u64 tag, T* n);
+
+						atom_ptr()												{ }
+						atom_ptr(T* p)											{ store(p); }
+
+		protected:
+#if defined(TARGET_64BIT) && (defined(__x86_64__) || defined(_M_X64)) && !defined(D_ATOMIC_PTR_WIDE)
+			static u64	pack(T* p, u64 tag)										{ return (tag << 48) | ((u64)(xsize_t)p & D_CONSTANT_U64(0x0000ffffffffffff)); }
+
+			atom_u64	_data;
+#elif defined(TARGET_64BIT)
+			atom_u128	_data;
+#else
+			static u64	pack(T* p, u64 tag)										{ return (tag << 32) | (u64)(u32)(xsize_t)p; }
+
+			atom_u64	_data;
+#endif
+		};
+
+#if defined(TARGET_64BIT) && (defined(__x86_64__) || defined(_M_X64)) && !defined(D_ATOMIC_PTR_WIDE)
+		template <class T>
+		inline T*		atom_ptr<T>::load(u64& tag) const
+		{
+			u64 const w = _data.get();
+			tag = w >> 48;
+			// Sign extend bit 47 to restore the canonical address
+			return (T*)(xsize_t)((s64)(w << 16) >> 16);
+		}
+
+		template <class T>
+		inline bool		atom_ptr<T>::cas(T* old, u64 tag, T* n)
+		{
+			return _data.cas(pack(old, tag), pack(n, tag + 1));
+		}
+#elif defined(TARGET_64BIT)
+		template <class T>
+		inline T*		atom_ptr<T>::load(u64& tag) const
+		{
+			u128 const w = _data.get();
+			tag = w.hi;
+			return (T*)(xsize_t)w.lo;
+		}
+
+		template <class T>
+		inline bool		atom_ptr<T>::cas(T* old, u64 tag, T* n)
+		{
+			return _data.cas((u64)(xsize_t)old, tag, (u64)(xsize_t)n, tag + 1);
+		}
+#else
+		template <class T>
+		inline T*		atom_ptr<T>::load(u64& tag) const
+		{
+			u64 const w = _data.get();
+			tag = w >> 32;
+			return (T*)(xsize_t)(u32)w;
+		}
 
+		template <class T>
+		inline bool		atom_ptr<T>::cas(T* old, u64 tag, T* n)
+		{
+			return _data.cas(pack(old, tag), pack(n, (tag + 1) & 0xffffffff));
+		}
+#endif
+	}
+}
 
 #endif // __CMULTICORE_ATOMIC_H__
@@ -22,16 +22,53 @@ namespace ncore
 		void		memr();
 		void		memw();
 		void		memrw();
+
+		/**
+		 * Spin-wait hint, lets the core know we are busy waiting (pause, yield).
+		 */
+		void		pause();
+
+		/**
+		 * Give up the remainder of the time slice to another thread.
+		 */
+		void		yield();
+
+		/**
+		 * Asymmetric fence pair for read-mostly data.
+		 * The frequent side (e.g. a reader announcing itself) calls asymmetric_light(),
+		 * which only stops the compiler. The rare side calls asymmetric_heavy(), which
+		 * runs a full barrier on every thread of the process that is running at that
+		 * moment (membarrier(2) on Linux, FlushProcessWriteBuffers on Windows). Together
+		 * they order like memrw() on both sides. The heavy side is a system call that
+		 * costs microseconds, do not use it on a fast path.
+		 * Where the OS has no such call both sides are a memrw(), asymmetric_native()
+		 * tells which one is in use, the choice is made once when the process starts.
+		 */
+		void		asymmetric_light();
+		void		asymmetric_heavy();
+		bool		asymmetric_native();
 	} // namespace barrier
 }
 
 
-#if defined(TARGET_PC)
+#if defined(D_ATOMIC_STD)
+	#include "catomic/private/c_barrier_std.h"
+#elif defined(TARGET_PC)
 	#if defined(TARGET_32BIT)
 		#include "catomic/private/c_barrier_x86_win32.h"
 	#else
 		#include "catomic/private/c_barrier_x86_win64.h"
 	#endif
+#elif defined(TARGET_LINUX)
+	#if defined(__x86_64__)
+		#include "catomic/private/c_barrier_x86_linux64.h"
+	#elif defined(__aarch64__) && defined(D_ATOMIC_ARM64)
+		// Not run on AArch64 hardware or qemu yet, opt in with D_ATOMIC_ARM64,
+		// other AArch64 builds define D_ATOMIC_STD
+		#include "catomic/private/c_barrier_arm64.h"
+	#else
+		#error Unsupported CPU
+	#endif
 #elif defined(TARGET_360)
 	#include "catomic/private/c_barrier_ppc_360.h"
 #elif defined(TARGET_PS3)
@@ -44,4 +81,130 @@ namespace ncore
 	#error Unsupported CPU
 #endif
 
+#if defined(TARGET_LINUX)
+	#include "catomic/private/c_membarrier_linux.h"
+#elif defined(TARGET_PC)
+	#include "catomic/private/c_membarrier_win.h"
+#else
+namespace ncore
+{
+	namespace barrier
+	{
+		// No way to interrupt the other threads, both sides fence
+		inline bool asymmetric_native()			{ return false; }
+		force_inline void asymmetric_light()	{ memrw(); }
+		force_inline void asymmetric_heavy()	{ memrw(); }
+	}
+}
+#endif
+
+namespace ncore
+{
+	/**
+	 * Contention backoff policies for cas retry loops.
+	 * A policy object is created at the start of a retry loop and wait() is
+	 * called after every failed cas. Used as a compile-time parameter by
+	 * lifo, fifo, mempool, stack and queue.
+	 */
+	namespace backoff
+	{
+		/**
+		 * Retry immediately.
+		 */
+		struct none
+		{
+			force_inline void	wait()								{ }
+		};
+
+		/**
+		 * Issue a single spin-wait hint before retrying.
+		 */
+		struct pause
+		{
+			force_inline void	wait()								{ barrier::pause(); }
+		};
+
+		/**
+		 * Spin for 1, 2, 4 .. MAX spin-wait hints, doubling on every failure.
+		 * The last step is clamped to MAX when it is not a power of two.
+		 */
+		template <u32 MAX = 1024>
+		struct exponential
+		{
+			u32					_spins;
+
+								exponential() : _spins(1)			{ }
+
+			force_inline void	wait()
+			{
+				for (u32 i = 0; i < _spins; ++i)
+					barrier::pause();
+				if (_spins < MAX)
+					_spins = (_spins << 1) < MAX ? (_spins << 1) : MAX;
+			}
+		};
+
+		/**
+		 * Like exponential, but once MAX is reached the thread yields its
+		 * time slice instead of spinning. Useful when there are more threads
+		 * than cores.
+		 */
+		template <u32 MAX = 1024>
+		struct exponential_yield
+		{
+			u32					_spins;
+
+								exponential_yield() : _spins(1)		{ }
+
+			force_inline void	wait()
+			{
+				if (_spins >= MAX)
+				{
+					barrier::yield();
+					return;
+				}
+				for (u32 i = 0; i < _spins; ++i)
+					barrier::pause();
+				_spins = (_spins << 1) < MAX ? (_spins << 1) : MAX;
+			}
+		};
+
+		/**
+		 * Spin-then-park for consumers waiting on a 32 bit atomic word, e.g. a
+		 * sequence number that producers bump and notify after a push.
+		 * wait() spins up to SPINS spin-wait hints while the word still holds
+		 * 'expected' and then sleeps in word.wait(expected) until it changes.
+		 *
+		 *   u32 seq = pushed.load_acquire();
+		 *   while (!ring.pop(item))
+		 *   {
+		 *       park.wait(pushed, seq);
+		 *       seq = pushed.load_acquire();
+		 *   }
+		 */
+		template <u32 SPINS = 1024>
+		struct spin_then_park
+		{
+			template <class A, class T>
+			void				wait(A& word, T expected)
+			{
+				for (u32 i = 0; i < SPINS; ++i)
+				{
+					if (word.load_relaxed() != expected)
+						return;
+					barrier::pause();
+				}
+				word.wait(expected);
+			}
+		};
+
+		/**
+		 * Default policy for the lock-free containers.
+		 * Chosen with the bench_backoff suite (built with D_ATOMIC_BENCH), run it
+		 * again on the target hardware before changing this.
+		 */
+		typedef exponential<>		standard;
+	} // namespace backoff
+}
+
 #endif // __CMULTICORE_BARRIER_H__
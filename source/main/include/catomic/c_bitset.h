@@ -0,0 +1,178 @@
+#ifndef __CMULTICORE_BITSET_H__
+#define __CMULTICORE_BITSET_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE 
+#pragma once 
+#endif
+
+#include "ccore/c_debug.h"
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/private/c_cpu.h"
+#include "catomic/c_atomic.h"
+
+#if defined(COMPILER_WINDOWS_MSVC)
+#include <intrin.h>
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		namespace cpu_bits
+		{
+			// Index of the lowest set bit, v must be non zero (tzcnt/bsf)
+			force_inline u32 sFindFirstSet(u64 v)
+			{
+#if defined(COMPILER_WINDOWS_MSVC) && defined(TARGET_32BIT)
+				unsigned long i;
+				if (_BitScanForward(&i, (unsigned long)v))
+					return (u32)i;
+				_BitScanForward(&i, (unsigned long)(v >> 32));
+				return (u32)i + 32;
+#elif defined(COMPILER_WINDOWS_MSVC)
+				unsigned long i;
+				_BitScanForward64(&i, v);
+				return (u32)i;
+#else
+				return (u32)__builtin_ctzll(v);
+#endif
+			}
+
+			// Number of set bits. MSVC's __popcnt emits POPCNT whatever the target cpu,
+			// so it counts in registers like __builtin_popcountll does without -mpopcnt.
+			force_inline u32 sCount(u64 v)
+			{
+#if defined(COMPILER_WINDOWS_MSVC)
+				v = v - ((v >> 1) & D_CONSTANT_U64(0x5555555555555555));
+				v = (v & D_CONSTANT_U64(0x3333333333333333)) + ((v >> 2) & D_CONSTANT_U64(0x3333333333333333));
+				v = (v + (v >> 4)) & D_CONSTANT_U64(0x0f0f0f0f0f0f0f0f);
+				return (u32)((v * D_CONSTANT_U64(0x0101010101010101)) >> 56);
+#else
+				return (u32)__builtin_popcountll(v);
+#endif
+			}
+		}
+
+		/**
+		* Lock-free bitset of N bits, used as a slot allocator.
+		* acquire_any() finds a clear bit, sets it and returns its index, release()
+		* clears it again. Unlike the lifo in mempool, which has one _head that every
+		* thread cas-es, threads here start scanning at different cache lines (the
+		* hint) and only contend when they race for bits in the same word.
+		* Acquire and release have acquire and release semantics for the slot data.
+		*/
+		template <u32 N>
+		class atomic_bitset
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			enum
+			{
+				WORDS = (N + 63) / 64,
+				WORDS_PER_LINE = DCORE_CACHELINE_SIZE / 8,
+			};
+
+			/**
+			* Construct with all bits clear.
+			*/
+						atomic_bitset()											{ reset(); }
+
+			/**
+			* Clear all bits.
+			* @warning Not thread safe
+			*/
+			void		reset()
+			{
+				for (u32 w = 0; w < WORDS; ++w)
+					_words[w].store_relaxed(0);
+				// Bits past N are permanently set so that they are never handed out
+				if ((N & 63) != 0)
+					_words[WORDS - 1].store_relaxed(~(u64)0 << (N & 63));
+			}
+
+			u32			max_size() const										{ return N; }
+
+			/**
+			* Find a clear bit and set it.
+			* @param[out] i index of the acquired bit
+			* @param[in] hint where to start looking, e.g. a thread or cpu number
+			* @return false if all bits are set
+			*/
+			bool		acquire_any(u32& i, u32 hint)
+			{
+				u32 const start = (hint * WORDS_PER_LINE) % WORDS;
+				u32 w = start;
+				do
+				{
+					u64 v = _words[w].load_relaxed();
+					while (v != ~(u64)0)
+					{
+						u32 const b = cpu_bits::sFindFirstSet(~v);
+						if (!_words[w].bit_test_set(b))
+						{
+							i = (w * 64) + b;
+							return true;
+						}
+						// Lost the race for this bit, look again at the same word
+						v = _words[w].load_relaxed();
+					}
+					if (++w == WORDS)
+						w = 0;
+				} while (w != start);
+				return false;
+			}
+
+			/**
+			* Find a clear bit and set it, starting at the current cpu.
+			*/
+			bool		acquire_any(u32& i)										{ return acquire_any(i, cpu_current::sIndex()); }
+
+			/**
+			* Set bit i when it is clear.
+			* @return false if it was already set
+			*/
+			bool		acquire(u32 i)
+			{
+				ASSERT(i < N);
+				return !_words[i >> 6].bit_test_set(i & 63);
+			}
+
+			/**
+			* Clear bit i, it must be set.
+			*/
+			void		release(u32 i)
+			{
+				ASSERT(i < N);
+				bool const was_set = _words[i >> 6].bit_test_clr(i & 63);
+				ASSERTS(was_set, "ncore::atomic::atomic_bitset: Error, releasing a clear bit");
+			}
+
+			bool		test(u32 i) const
+			{
+				ASSERT(i < N);
+				return (_words[i >> 6].load_acquire() & ((u64)1 << (i & 63))) != 0;
+			}
+
+			/**
+			* Number of set bits.
+			* @return approximate number of set bits while other threads are busy
+			*/
+			u32			count() const
+			{
+				u32 c = 0;
+				for (u32 w = 0; w < WORDS; ++w)
+					c += cpu_bits::sCount(_words[w].load_relaxed());
+				return c - (WORDS * 64 - N);
+			}
+
+		protected:
+			atom_u64	_words[WORDS];
+		};
+	} // namespace atomic
+} // namespace ncore
+
+#endif // __CMULTICORE_BITSET_H__
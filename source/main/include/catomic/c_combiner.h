@@ -0,0 +1,283 @@
+#ifndef __CMULTICORE_COMBINER_H__
+#define __CMULTICORE_COMBINER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_debug.h"
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_bitset.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		/**
+		* Flat combining (Hendler, Incze, Shavit and Tzafrir).
+		* Turns a sequential data structure into a concurrent one. A thread publishes
+		* its request in its own padded record and tries to take the combiner lock,
+		* the thread that gets it applies all published requests in one batch while
+		* the others spin on their record until it is done. The structure stays in
+		* the combiner's cache and the lock changes hands once per batch instead of
+		* once per operation, which wins under high contention.
+		*
+		* DS is a sequential structure with:
+		*
+		*     struct request;                                        // copied into the record
+		*     struct response;                                       // copied out of the record
+		*     void execute(request const& req, response& res);       // one operation
+		*
+		* Every thread calls attach() once to get its index and passes it to
+		* execute(), at most THREADS threads at the same time.
+		*/
+		template <class DS, u32 THREADS = 64, class BACKOFF = backoff::exponential_yield<> >
+		class flat_combiner
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			typedef typename DS::request	request;
+			typedef typename DS::response	response;
+
+			enum
+			{
+				MAX_PASSES = 4,		///< scans of the records per batch, ends early when a scan finds nothing
+			};
+
+						flat_combiner()											{ _lock.store_relaxed(0); _used.store_relaxed(0); }
+
+			/**
+			* Claim a thread index.
+			* @return the index, or THREADS when all of them are taken
+			*/
+			u32			attach()
+			{
+				u32 tid;
+				if (!_threads.acquire_any(tid))
+					return THREADS;
+				_records[tid].state.store_relaxed(IDLE);
+				_used.fetch_max(tid + 1);
+				return tid;
+			}
+
+			/**
+			* Give the thread index back, the thread must not use it anymore.
+			*/
+			void		detach(u32 tid)											{ _threads.release(tid); }
+
+			/**
+			* Have 'req' applied to the structure, by this thread or by the combiner.
+			*/
+			void		execute(u32 tid, request const& req, response& res)
+			{
+				ASSERT(tid < THREADS);
+				record& r = _records[tid];
+				r.req = req;
+				r.state.store_release(PENDING);
+
+				BACKOFF delay;
+				while (r.state.load_acquire() != DONE)
+				{
+					if (_lock.load_relaxed() == 0 && _lock.cas_acquire(0, 1))
+					{
+						combine();
+						_lock.store_release(0);
+					}
+					else
+					{
+						delay.wait();
+					}
+				}
+				res = r.res;
+				r.state.store_relaxed(IDLE);
+			}
+
+			/**
+			* The structure itself, only for use while no thread calls execute().
+			*/
+			DS&			data()													{ return _ds; }
+
+		protected:
+			enum
+			{
+				IDLE = 0,
+				PENDING = 1,
+				DONE = 2,
+			};
+
+			struct DCORE_CACHELINE_ALIGN record
+			{
+				atom_u32		state;
+				request			req;
+				response		res;
+			};
+
+			void		combine()
+			{
+				u32 const used = _used.load_acquire();
+				for (u32 pass = 0; pass < MAX_PASSES; ++pass)
+				{
+					u32 applied = 0;
+					for (u32 i = 0; i < used; ++i)
+					{
+						record& r = _records[i];
+						if (r.state.load_acquire() != PENDING)
+							continue;
+						_ds.execute(r.req, r.res);
+						r.state.store_release(DONE);
+						++applied;
+					}
+					if (applied == 0)
+						break;
+				}
+			}
+
+			record					_records[THREADS];
+			DCORE_CACHELINE_ALIGN atom_u32	_lock;
+			atom_u32				_used;
+			DCORE_CACHELINE_ALIGN DS	_ds;
+			atomic_bitset<THREADS>	_threads;
+		};
+
+		/**
+		* Bounded binary min-heap, sequential, the demo structure for flat_combiner.
+		*/
+		template <class T, u32 CAPACITY>
+		class sequential_heap
+		{
+		public:
+			enum
+			{
+				PUSH = 0,
+				POP = 1,
+			};
+
+			struct request
+			{
+				u32		op;
+				T		value;
+			};
+
+			struct response
+			{
+				bool	ok;
+				T		value;
+			};
+
+						sequential_heap() : _size(0)							{ }
+
+			u32			size() const											{ return _size; }
+
+			bool		push(T const& v)
+			{
+				if (_size == CAPACITY)
+					return false;
+				u32 i = _size++;
+				while (i > 0 && v < _items[(i - 1) / 2])
+				{
+					_items[i] = _items[(i - 1) / 2];
+					i = (i - 1) / 2;
+				}
+				_items[i] = v;
+				return true;
+			}
+
+			bool		pop(T& v)
+			{
+				if (_size == 0)
+					return false;
+				v = _items[0];
+				T const last = _items[--_size];
+				u32 i = 0;
+				for (;;)
+				{
+					u32 c = i * 2 + 1;
+					if (c >= _size)
+						break;
+					if (c + 1 < _size && _items[c + 1] < _items[c])
+						++c;
+					if (!(_items[c] < last))
+						break;
+					_items[i] = _items[c];
+					i = c;
+				}
+				_items[i] = last;
+				return true;
+			}
+
+			void		execute(request const& req, response& res)
+			{
+				if (req.op == PUSH)
+					res.ok = push(req.value);
+				else
+					res.ok = pop(res.value);
+			}
+
+		protected:
+			u32			_size;
+			T			_items[CAPACITY];
+		};
+
+		/**
+		* Concurrent min-heap through flat combining.
+		*/
+		template <class T, u32 CAPACITY, u32 THREADS = 64>
+		class combining_heap
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			typedef sequential_heap<T, CAPACITY>	heap_t;
+
+			u32			attach()												{ return _fc.attach(); }
+			void		detach(u32 tid)											{ _fc.detach(tid); }
+
+			/**
+			* @return false when the heap is full
+			*/
+			bool		push(u32 tid, T const& v)
+			{
+				typename heap_t::request req;
+				req.op = heap_t::PUSH;
+				req.value = v;
+				typename heap_t::response res;
+				_fc.execute(tid, req, res);
+				return res.ok;
+			}
+
+			/**
+			* Take the smallest item.
+			* @return false when the heap is empty
+			*/
+			bool		pop(u32 tid, T& v)
+			{
+				typename heap_t::request req;
+				req.op = heap_t::POP;
+				req.value = T();
+				typename heap_t::response res;
+				_fc.execute(tid, req, res);
+				if (res.ok)
+					v = res.value;
+				return res.ok;
+			}
+
+			/**
+			* Number of items, only exact while no thread pushes or pops.
+			*/
+			u32			size()													{ return _fc.data().size(); }
+
+		protected:
+			flat_combiner<heap_t, THREADS>	_fc;
+		};
+
+	} // namespace atomic
+} // namespace ncore
+
+
+#endif // __CMULTICORE_COMBINER_H__
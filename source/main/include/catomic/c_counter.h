@@ -0,0 +1,95 @@
+#ifndef __CMULTICORE_COUNTER_H__
+#define __CMULTICORE_COUNTER_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE 
+#pragma once 
+#endif
+
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/private/c_cpu.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_percpu.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		/**
+		* Striped counter for high-frequency statistics.
+		* Every slot is an atom_s64 on its own cache line and a thread updates the
+		* slot of the cpu it is running on. Threads on different cpus never touch the
+		* same line, so updates do not contend. read() sums all slots, it is exact
+		* once updates have stopped and otherwise an approximate snapshot.
+		* When N covers percpu_slots() and rseq is available, a slot belongs to
+		* exactly one cpu and is updated with percpu_add(), which has no lock prefix.
+		* @tparam N number of slots, power of two, ideally >= number of cpus
+		*/
+		template <u32 N = 64>
+		class striped_counter
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						striped_counter()										{ }
+
+			void		add(s64 v)												{ update(v); }
+			void		sub(s64 v)												{ update(-v); }
+			void		incr()													{ update(1); }
+			void		decr()													{ update(-1); }
+
+			/**
+			* Sum of all slots.
+			*/
+			s64			read() const
+			{
+				s64 sum = 0;
+				for (u32 i = 0; i < N; ++i)
+					sum += _slots[i].load_relaxed();
+				return sum;
+			}
+
+			/**
+			* Reset all slots to zero.
+			* @warning concurrent updates may be lost
+			*/
+			void		reset()
+			{
+				for (u32 i = 0; i < N; ++i)
+					_slots[i].store_relaxed(0);
+			}
+
+		protected:
+			// Per-cpu updates are only safe when no two cpus share a slot, and since
+			// they are not atomic all threads have to use them or none.
+			static bool	sPerCpu()
+			{
+				static bool const percpu = percpu_rseq_available() && percpu_slots() <= N;
+				return percpu;
+			}
+
+			void		update(s64 v)
+			{
+				if (sPerCpu())
+				{
+					u32 cpu;
+					do
+					{
+						cpu = percpu_cpu();
+					} while (percpu_add(cpu, &_slots[cpu], v) == percpu_restart);
+					return;
+				}
+				_slots[cpu_current::sIndex() & (N - 1)].add(v);
+			}
+
+			atom_padded<atom_s64>	_slots[N];
+
+		private:
+			typedef char n_must_be_a_power_of_two[(N & (N - 1)) == 0 ? 1 : -1];
+		};
+	} // namespace atomic
+} // namespace ncore
+
+#endif // __CMULTICORE_COUNTER_H__
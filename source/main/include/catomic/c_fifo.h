@@ -61,12 +61,20 @@ namespace ncore
 				LAST   = 0xfffffffe,
 			};
 
-			state		_head;
-			state		_tail;
+			// Read-only after init, shared by all threads
 			link*		_chain;
 			u32			_max_size;
 			alloc_t* _allocator;
 
+			bool		_track_high_water;
+
+			// Consumers move the head and producers the tail, each on its own cache line
+			DCORE_CACHELINE_ALIGN state	_head;
+			DCORE_CACHELINE_ALIGN state	_tail;
+
+			// Optional high-water mark, any producer may raise it so it gets a line of its own
+			atom_padded<atom_u32>	_high_water;
+
 		public:
 			/**
 			* Create empty lifo. It can be initialized lated by calling init().
@@ -74,9 +82,10 @@ namespace ncore
 						fifo() 
 							: _chain(NULL)
 							, _max_size(0)
-							, _allocator(NULL)									{ }
+							, _allocator(NULL)
+							, _track_high_water(false)							{ }
 
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 16)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 			/**
 			* Destroy lifo.
@@ -125,8 +134,8 @@ namespace ncore
 			*/
 			u32			room() const
 			{
-				u32 const h = _head.next_salt32.salt;
-				u32 const t = _tail.next_salt32.salt;
+				u32 const h = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);
+				u32 const t = read_u32_acquire((u32 volatile*)&_tail.next_salt32.salt);
 
 				u32 used = (h < t) ? (t - h) : (h - t);
 				if (used > _max_size)
@@ -140,8 +149,8 @@ namespace ncore
 			*/
 			u32			size() const
 			{
-				u32 const h = _head.next_salt32.salt;
-				u32 const t = _tail.next_salt32.salt;
+				u32 const h = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);
+				u32 const t = read_u32_acquire((u32 volatile*)&_tail.next_salt32.salt);
 
 				u32 used = (h < t) ? (t - h) : (h - t);
 				if (used > _max_size)
@@ -155,8 +164,8 @@ namespace ncore
 			*/
 			bool		empty() const
 			{
-				u32 hs = _head.next_salt32.salt;
-				u32 ts = _tail.next_salt32.salt;
+				u32 hs = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);
+				u32 ts = read_u32_acquire((u32 volatile*)&_tail.next_salt32.salt);
 				return (ts == hs);
 			}
 
@@ -167,8 +176,8 @@ namespace ncore
 			bool		inside(u32 cursor) const
 			{
 				u64 c = cursor;
-				u64 h = _head.next_salt32.salt;	// pop
-				u64 t = _tail.next_salt32.salt;	// push
+				u64 h = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);	// pop
+				u64 t = read_u32_acquire((u32 volatile*)&_tail.next_salt32.salt);	// push
 
 				if (t < h)
 					t += D_CONSTANT_U64(0x0000000100000000);
@@ -176,6 +185,18 @@ namespace ncore
 				return (c>=h && c<t);
 			}
 
+			/**
+			* Enable or disable tracking of the largest size() seen after a push.
+			* Costs a size() computation and a relaxed load per push when enabled.
+			*/
+			void		track_high_water(bool enable)						{ _track_high_water = enable; }
+
+			/**
+			* Largest size() seen after a push since the last reset_high_water().
+			*/
+			u32			high_water() const									{ return _high_water.load_relaxed(); }
+			void		reset_high_water()									{ _high_water.store_relaxed(0); }
+
 			/**
 			* Reset fifo state.
 			* @warning not thread safe
@@ -208,20 +229,28 @@ namespace ncore
 			/**
 			* Inline version of the @see push().
 			* Most people should use regular version.
+			* @tparam B backoff policy applied when the cas fails, @see backoff
 			*/
+			template <class B>
 			bool		ipush(u32 i, u32& outCursor);
+			bool		ipush(u32 i, u32& outCursor)							{ return ipush<backoff::standard>(i, outCursor); }
 
 			/**
 			* Inline version of the @see pop().
 			* Most people should use regular version.
+			* @tparam B backoff policy applied when the cas fails, @see backoff
 			*/
+			template <class B>
 			bool		ipop(u32 &i, u32 &r);
+			bool		ipop(u32 &i, u32 &r)									{ return ipop<backoff::standard>(i, r); }
 		};
 
+		template <class B>
 		inline bool fifo::ipush(u32 i, u32& outCursor)
 		{
 			u32 n;
 			state t;
+			B delay;
 
 			if (i > _max_size)
 				return false;
@@ -237,13 +266,14 @@ namespace ncore
 			// Loop until push is successful
 			while (1)
 			{
-				t.next_salt64 = _tail.next_salt64;
-				n             = _chain[t.next_salt32.next].next;
+				t.next_salt64 = read_u64_acquire(&_tail.next_salt64);
+				n             = read_u32_acquire(&_chain[t.next_salt32.next].next);
 				if (n == LAST) 
 				{
 					// Try to link this element to the tail element
 					if (cas_u32((ncore::u32 volatile*)&_chain[t.next_salt32.next].next, LAST, i))
 						break;
+					delay.wait();
 				} 
 				else
 				{
@@ -260,20 +290,25 @@ namespace ncore
 
 			outCursor = t.next_salt32.salt;
 
+			if (_track_high_water)
+				_high_water.fetch_max(size());
+
 			return true;
 		}
 
+		template <class B>
 		inline bool fifo::ipop(u32 &i, u32 &r)
 		{
 			u32 n;
 			state h, t;
+			B delay;
 
 			// Loop until pop is successful or the fifo is empty.
 			while (1) 
 			{
-				h.next_salt64 = _head.next_salt64;
-				t.next_salt64 = _tail.next_salt64;
-				n             = _chain[h.next_salt32.next].next;
+				h.next_salt64 = read_u64_acquire(&_head.next_salt64);
+				t.next_salt64 = read_u64_acquire(&_tail.next_salt64);
+				n             = read_u32_acquire(&_chain[h.next_salt32.next].next);
 
 				if (t.next_salt32.next == h.next_salt32.next)
 				{
@@ -295,6 +330,7 @@ namespace ncore
 					// Try to re point it to the next element
 					if (cas_u64(&_head.next_salt64, h.next_salt32.next, h.next_salt32.salt, n, h.next_salt32.salt + 1))
 						break;
+					delay.wait();
 				}
 			}
 
@@ -0,0 +1,308 @@
+#ifndef __CMULTICORE_KCAS_H__
+#define __CMULTICORE_KCAS_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_debug.h"
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_bitset.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		template <u32 THREADS, u32 K> class kcas_domain;
+
+		/**
+		* Word that takes part in a multi-word cas.
+		* Holds a 62 bit value, the low 2 bits of the underlying u64 mark a descriptor
+		* installed by an operation in flight. Only read and change it through the
+		* kcas_domain that owns it.
+		*/
+		class kcas_word
+		{
+		public:
+			static const u64	VALUE_MAX = D_CONSTANT_U64(0x3fffffffffffffff);
+
+						kcas_word()												{ _data.store_relaxed(0); }
+						kcas_word(u64 v)										{ ASSERT(v <= VALUE_MAX); _data.store_relaxed(v << 2); }
+
+		protected:
+			template <u32 THREADS, u32 K> friend class kcas_domain;
+
+			atom_u64	_data;
+		};
+
+		/**
+		* Lock-free multi-word compare-and-swap (Harris, Fraser and Pratt).
+		* kcas() installs a descriptor in every word in address order through a
+		* restricted double-compare single-swap (RDCSS), decides, then replaces the
+		* descriptor with the new or the old values. A thread that meets a descriptor
+		* helps that operation to completion before it continues, so a stalled
+		* thread never blocks the others.
+		*
+		* Descriptors are not allocated, every thread owns one kcas and one rdcss
+		* descriptor that it reuses (Arbel-Raviv and Brown). A word holds a reference
+		* of thread index and sequence number, a helper copies the descriptor and then
+		* checks the sequence number to detect that the operation already finished.
+		*
+		* Every thread calls attach() once to get its index and passes it to read()
+		* and kcas(), at most THREADS threads at the same time. K is the largest
+		* number of words in one kcas().
+		*/
+		template <u32 THREADS = 64, u32 K = 4>
+		class kcas_domain
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			struct entry
+			{
+				kcas_word*	addr;
+				u64			expected;
+				u64			desired;
+			};
+
+						kcas_domain()											{ }
+
+			/**
+			* Claim a thread index.
+			* @return the index, or THREADS when all of them are taken
+			*/
+			u32			attach()
+			{
+				u32 tid;
+				if (!_threads.acquire_any(tid))
+					return THREADS;
+				return tid;
+			}
+
+			/**
+			* Give the thread index back, the thread must not use it anymore.
+			*/
+			void		detach(u32 tid)											{ _threads.release(tid); }
+
+			/**
+			* Read the value of a word, helping any operation that is busy with it.
+			*/
+			u64			read(kcas_word& w, u32 tid)
+			{
+				ASSERT(tid < THREADS);
+				for (;;)
+				{
+					u64 const v = rdcss_read(w._data);
+					if ((v & TAG_KCAS) == 0)
+						return v >> 2;
+					help(tid, v);
+				}
+			}
+
+			/**
+			* Set every entry's word to 'desired' when all of them hold 'expected', as
+			* one atomic step. The words must be distinct, the entries can be in any order.
+			* @return false when at least one word did not hold its expected value
+			*/
+			bool		kcas(u32 tid, entry const* entries, u32 n)
+			{
+				ASSERT(tid < THREADS);
+				ASSERT(n <= K);
+
+				// Words are claimed in address order, otherwise two operations on the
+				// same words could keep undoing each other
+				u32 order[K];
+				for (u32 i = 0; i < n; ++i)
+				{
+					u32 j = i;
+					for (; j > 0 && entries[order[j - 1]].addr > entries[i].addr; --j)
+						order[j] = order[j - 1];
+					order[j] = i;
+				}
+
+				kcas_desc& d = _kcas[tid];
+				u64 const seq = (d.mutables.load_relaxed() >> 2) + 1;
+				// An exchange and not a store, the descriptor fields below must not
+				// become visible before the new sequence number
+				d.mutables.exchange(seq << 2 | STATE_UNDECIDED);
+				d.n.set(n);
+				for (u32 i = 0; i < n; ++i)
+				{
+					entry const& e = entries[order[i]];
+					ASSERT(i == 0 || e.addr != entries[order[i - 1]].addr);
+					ASSERT(e.expected <= kcas_word::VALUE_MAX && e.desired <= kcas_word::VALUE_MAX);
+					d.addr[i].set((u64)(xsize_t)&e.addr->_data);
+					d.expected[i].set(e.expected << 2);
+					d.desired[i].set(e.desired << 2);
+				}
+				return help(tid, sRef(tid, seq, TAG_KCAS));
+			}
+
+		protected:
+			enum
+			{
+				STATE_UNDECIDED = 0,
+				STATE_SUCCEEDED = 1,
+				STATE_FAILED = 2,
+
+				TAG_RDCSS = 1,
+				TAG_KCAS = 2,
+
+				TID_BITS = 10,
+				SEQ_SHIFT = 2 + TID_BITS,
+			};
+
+			typedef char	check_threads[(THREADS <= (1 << TID_BITS) && K > 0) ? 1 : -1];
+
+			// Reference in a word: sequence number, thread index and tag
+			static u64	sRef(u32 tid, u64 seq, u64 tag)							{ return (seq << SEQ_SHIFT) | ((u64)tid << 2) | tag; }
+			static u32	sTid(u64 ref)											{ return (u32)(ref >> 2) & ((1 << TID_BITS) - 1); }
+			static u64	sSeq(u64 ref)											{ return ref >> SEQ_SHIFT; }
+
+			// mutables holds the sequence number and the state, so a helper can only
+			// decide the operation it copied
+			struct DCORE_CACHELINE_ALIGN kcas_desc
+			{
+				atom_u64	mutables;
+				atom_u32	n;
+				atom_u64	addr[K];
+				atom_u64	expected[K];
+				atom_u64	desired[K];
+			};
+
+			struct DCORE_CACHELINE_ALIGN rdcss_desc
+			{
+				atom_u64	seq;
+				atom_u64	kcas_ref;
+				atom_u64	addr;
+				atom_u64	expected;
+			};
+
+			// State of the operation behind a kcas reference, an operation that is
+			// no longer in the descriptor has been decided
+			u64			state(u64 kref) const
+			{
+				u64 const m = _kcas[sTid(kref)].mutables.get();
+				if ((m >> 2) != sSeq(kref))
+					return STATE_FAILED;
+				return m & 3;
+			}
+
+			u64			rdcss_read(atom_u64& a)
+			{
+				for (;;)
+				{
+					u64 const v = a.get();
+					if ((v & TAG_RDCSS) == 0)
+						return v;
+					rdcss_complete(v);
+				}
+			}
+
+			// Install kref in a when a holds 'expected' and kref is still undecided
+			// @return the value found in a, 'expected' on success
+			u64			rdcss(u32 tid, u64 kref, atom_u64& a, u64 expected)
+			{
+				rdcss_desc& d = _rdcss[tid];
+				u64 const seq = d.seq.load_relaxed() + 1;
+				d.seq.exchange(seq);
+				d.kcas_ref.set(kref);
+				d.addr.set((u64)(xsize_t)&a);
+				d.expected.set(expected);
+
+				u64 const ref = sRef(tid, seq, TAG_RDCSS);
+				for (;;)
+				{
+					if (a.cas(expected, ref))
+					{
+						rdcss_complete(ref);
+						return expected;
+					}
+					u64 const v = a.get();
+					if ((v & TAG_RDCSS) != 0)
+						rdcss_complete(v);
+					else if (v != expected)
+						return v;
+				}
+			}
+
+			void		rdcss_complete(u64 ref)
+			{
+				rdcss_desc const& d = _rdcss[sTid(ref)];
+				u64 const kref = d.kcas_ref.get();
+				atom_u64* a = (atom_u64*)(xsize_t)d.addr.get();
+				u64 const expected = d.expected.get();
+				// Reused already, then the owner has completed it
+				if (d.seq.get() != sSeq(ref))
+					return;
+				a->cas(ref, state(kref) == STATE_UNDECIDED ? kref : expected);
+			}
+
+			bool		help(u32 tid, u64 kref)
+			{
+				kcas_desc& d = _kcas[sTid(kref)];
+				u64 const seq = sSeq(kref);
+
+				atom_u64* addr[K];
+				u64 expected[K];
+				u64 desired[K];
+				u32 n = d.n.get();
+				if (n > K)
+					n = K;
+				for (u32 i = 0; i < n; ++i)
+				{
+					addr[i] = (atom_u64*)(xsize_t)d.addr[i].get();
+					expected[i] = d.expected[i].get();
+					desired[i] = d.desired[i].get();
+				}
+
+				// The copy is only valid while the sequence number has not moved, when
+				// it has the operation is finished and only its owner needs the result
+				u64 m = d.mutables.get();
+				if ((m >> 2) != seq)
+					return false;
+
+				if ((m & 3) == STATE_UNDECIDED)
+				{
+					u64 s = STATE_SUCCEEDED;
+					for (u32 i = 0; i < n && s == STATE_SUCCEEDED; ++i)
+					{
+						for (;;)
+						{
+							u64 const v = rdcss(tid, kref, *addr[i], expected[i]);
+							if (v == expected[i] || v == kref)
+								break;
+							if ((v & TAG_KCAS) == 0)
+							{
+								s = STATE_FAILED;
+								break;
+							}
+							help(tid, v);
+						}
+					}
+					d.mutables.cas(seq << 2 | STATE_UNDECIDED, seq << 2 | s);
+					m = d.mutables.get();
+					if ((m >> 2) != seq)
+						return false;
+				}
+
+				bool const succeeded = (m & 3) == STATE_SUCCEEDED;
+				for (u32 i = 0; i < n; ++i)
+					addr[i]->cas(kref, succeeded ? desired[i] : expected[i]);
+				return succeeded;
+			}
+
+			kcas_desc			_kcas[THREADS];
+			rdcss_desc			_rdcss[THREADS];
+			atomic_bitset<THREADS>	_threads;
+		};
+
+	} // namespace atomic
+} // namespace ncore
+
+
+#endif // __CMULTICORE_KCAS_H__
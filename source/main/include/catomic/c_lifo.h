@@ -74,11 +74,14 @@ namespace ncore
 				LAST   = 0xfffffffe,
 			};
 
-			state			_head;
+			// Read-only after init, shared by all threads
 			link*			_chain;
 			u32				_max_size;
 			alloc_t*	_allocator;
 
+			// Written by every push and pop, kept on its own cache line
+			DCORE_CACHELINE_ALIGN state	_head;
+
 			inline u32	increase_push(u32 salt)
 			{
 				u32 const cnt = ((salt & 0x0000ffff) + 0x00000001) & 0x0000ffff;
@@ -92,7 +95,7 @@ namespace ncore
 			}
 
 		public:
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 4)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 			/**
 			* Create empty lifo. It can be initialized later by calling init().
@@ -159,7 +162,7 @@ namespace ncore
 			*/
 			u32			room() const
 			{
-				u32 const s = _head.next_salt32.salt;
+				u32 const s = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);
 				u32 const h = (s & 0x0000ffff);
 				u32 const t = (s & 0xffff0000) >> 16;
 
@@ -176,7 +179,7 @@ namespace ncore
 			*/
 			u32			size() const
 			{
-				u32 const s = _head.next_salt32.salt;
+				u32 const s = read_u32_acquire((u32 volatile*)&_head.next_salt32.salt);
 				u32 const h = (s & 0x0000ffff);
 				u32 const t = (s & 0xffff0000) >> 16;
 
@@ -211,14 +214,20 @@ namespace ncore
 			/**
 			* Inline version of @see push().
 			* Most cases should use regular version.
+			* @tparam B backoff policy applied when the cas fails, @see backoff
 			*/
+			template <class B>
 			bool		ipush(u32 i);
+			bool		ipush(u32 i)											{ return ipush<backoff::standard>(i); }
 
 			/**
 			* Inline version of @see pop().
 			* Most cases should use regular version.
+			* @tparam B backoff policy applied when the cas fails, @see backoff
 			*/
+			template <class B>
 			bool		ipop(u32 &i);
+			bool		ipop(u32 &i)											{ return ipop<backoff::standard>(i); }
 
 			// Emulates fifo::pop() interface.
 			// Used in the unit-test
@@ -230,9 +239,11 @@ namespace ncore
 			}
 		};
 
+		template <class B>
 		inline bool lifo::ipush(u32 i)
 		{
 			state h;
+			B delay;
 
 			if (i >= _max_size)
 				return false;
@@ -243,35 +254,47 @@ namespace ncore
 				return false;
 
 			// Spin until push is successful 
-			do
+			while (1)
 			{
-				h.next_salt64 = _head.next_salt64;
+				// Relaxed, the head value is only used as the cas comparand.
+				h.next_salt64 = read_u64_relaxed(&_head.next_salt64);
 
 				_chain[i].next = h.next_salt32.next;
 				// We need write barrier here to make sure that _chain[i].next
 				// is visible on all CPUs before it's linked in.
 				barrier::memw();
-			} while (!cas_u64(&_head.next_salt64, h.next_salt32.next, h.next_salt32.salt, i, increase_push(h.next_salt32.salt)));
+
+				if (cas_u64(&_head.next_salt64, h.next_salt32.next, h.next_salt32.salt, i, increase_push(h.next_salt32.salt)))
+					break;
+				delay.wait();
+			}
 
 			return true;
 		}
 
+		template <class B>
 		inline bool lifo::ipop(u32 &i)
 		{
 			u32 n;
 			state h;
+			B delay;
 
 			// Spin until pop is successful
-			do
+			while (1)
 			{
-				h.next_salt64 = _head.next_salt64;
+				// Acquire, the next index of the head element is read below.
+				h.next_salt64 = read_u64_acquire(&_head.next_salt64);
 
 				// Empty ?
 				if (h.next_salt32.next == _max_size)
 					return false;
 
 				n = _chain[h.next_salt32.next].next;
-			} while (!cas_u64(&_head.next_salt64, h.next_salt32.next, h.next_salt32.salt, n, increase_pop(h.next_salt32.salt)));
+
+				if (cas_u64(&_head.next_salt64, h.next_salt32.next, h.next_salt32.salt, n, increase_pop(h.next_salt32.salt)))
+					break;
+				delay.wait();
+			}
 
 			i = h.next_salt32.next;
 
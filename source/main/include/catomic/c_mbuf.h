@@ -314,19 +314,19 @@ namespace ncore
 				*/
 				bool			cloned() const 
 				{ 
-					u32 c = _shared->refcnt.get();
+					u32 c = _shared->refcnt.load_acquire();
 					return (c - 1) != 0;
 				}
 
 				/**
 				* Number of users of this head (head refcount)
 				*/
-				u32				nusers() const									{ return _refcnt.get(); }
+				u32				nusers() const									{ return _refcnt.load_acquire(); }
 
 				/**
 				* Number of times it was cloned (data refcount)
 				*/
-				u32				nclones() const									{ return _shared->refcnt.get(); }
+				u32				nclones() const									{ return _shared->refcnt.load_acquire(); }
 
 				/**
 				* Resets the data pointers in the buffer.
@@ -33,9 +33,13 @@ namespace ncore
 			xbyte*			mBuffer;
 			u32				mCsize;
 			bool			mExtern;
+			bool			mTrackHighWater;
+			atom_padded<atom_u32>	mHighWater;		// optional, every get() may raise it
+
+			void		update_high_water()											{ mHighWater.fetch_max(mLifo.max_size() - mLifo.size()); }
 
 		public:
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 4)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 			/**
 			* Constructor.
@@ -99,6 +103,17 @@ namespace ncore
 			*/
 			u32			size() const												{ return mLifo.size(); }
 
+			/**
+			* Enable or disable tracking of the largest number of chunks in use at once.
+			*/
+			void		track_high_water(bool enable)								{ mTrackHighWater = enable; }
+
+			/**
+			* Largest number of chunks in use at once since the last reset_high_water().
+			*/
+			u32			high_water() const											{ return mHighWater.load_relaxed(); }
+			void		reset_high_water()											{ mHighWater.store_relaxed(0); }
+
 			/**
 			* Convert chunk pointer to index
 			* @return chunk index
@@ -121,6 +136,25 @@ namespace ncore
 			{
 				if (!mLifo.pop(i))
 					return NULL;
+				if (mTrackHighWater)
+					update_high_water();
+				return i2c(i);
+			}
+
+			/**
+			* Get free chunk from the pool.
+			* @tparam B backoff policy applied when the lifo cas fails, @see backoff
+			* @param[out] position (index) of the returned chunk
+			* @return pointer to the beginning if the chunk, or 0
+			* if there is no space.
+			*/
+			template <class B>
+			xbyte*		get(u32 &i)
+			{
+				if (!mLifo.ipop<B>(i))
+					return NULL;
+				if (mTrackHighWater)
+					update_high_water();
 				return i2c(i);
 			}
 
@@ -146,6 +180,18 @@ namespace ncore
 				ASSERTS(r, "ncore::atomic::mempool: Error, invalid index or double free");
 			}
 
+			/**
+			* Put chunk back into the pool.
+			* @tparam B backoff policy applied when the lifo cas fails, @see backoff
+			* @param[in] i chunk index
+			*/
+			template <class B>
+			void		put(u32 i)
+			{
+				bool r = mLifo.ipush<B>(i);
+				ASSERTS(r, "ncore::atomic::mempool: Error, invalid index or double free");
+			}
+
 			/**
 			* Put chunk back into the pool.
 			* @param[in] chunk pointer to the beginning of the chunk
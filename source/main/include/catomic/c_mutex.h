@@ -0,0 +1,196 @@
+#ifndef __CMULTICORE_MUTEX_H__
+#define __CMULTICORE_MUTEX_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		//-------------------------------------------------------------------------------------
+		// blocking mutex and condition variable
+		// Both park through atom_u32::wait() and notify_*(), futex(2) on Linux and
+		// WaitOnAddress on Windows. Without contention lock() and unlock() are one
+		// locked instruction each and never enter the kernel.
+		//-------------------------------------------------------------------------------------
+
+		/**
+		* Mutex with adaptive spinning (Drepper's three state futex lock).
+		* The lock word is 0 when free, 1 when locked and 2 when locked with threads
+		* that may be sleeping, only unlock() of state 2 issues a wake-up.
+		* A thread that finds the mutex locked first spins for a while, the number of
+		* spins follows a running average of what earlier acquisitions needed (up to
+		* MAX_SPINS), and then sleeps.
+		*/
+		class mutex
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			enum
+			{
+				MAX_SPINS = 128,
+			};
+
+						mutex()													{ _state.store_relaxed(UNLOCKED); _spins.store_relaxed(0); }
+
+			void		lock()
+			{
+				if (!_state.cas_acquire(UNLOCKED, LOCKED))
+					lock_contended();
+			}
+
+			bool		try_lock()												{ return _state.cas_acquire(UNLOCKED, LOCKED); }
+
+			void		unlock()
+			{
+				if (_state.exchange(UNLOCKED) == SLEEPERS)
+					_state.notify_one();
+			}
+
+			bool		is_locked() const										{ return _state.load_relaxed() != UNLOCKED; }
+
+			/**
+			* Holds the lock for the lifetime of the guard.
+			*/
+			class guard
+			{
+			public:
+						guard(mutex& m) : _mutex(m)								{ _mutex.lock(); }
+						~guard()												{ _mutex.unlock(); }
+
+			protected:
+				mutex&	_mutex;
+			};
+
+		protected:
+			friend class condvar;
+
+			enum
+			{
+				UNLOCKED = 0,
+				LOCKED = 1,
+				SLEEPERS = 2,
+			};
+
+			void		lock_contended()
+			{
+				// Spin up to twice the average, the average moves an eighth of the way
+				// towards the spins needed this time (or the limit when they ran out)
+				s32 const average = _spins.load_relaxed();
+				s32 const limit = (average * 2 + 16) < MAX_SPINS ? (average * 2 + 16) : MAX_SPINS;
+				s32 spins = 0;
+				for (; spins < limit; ++spins)
+				{
+					barrier::pause();
+					if (_state.load_relaxed() == UNLOCKED && _state.cas_acquire(UNLOCKED, LOCKED))
+					{
+						_spins.store_relaxed(average + (spins - average) / 8);
+						return;
+					}
+				}
+				_spins.store_relaxed(average + (spins - average) / 8);
+				lock_sleep();
+			}
+
+			// Mark the lock word as having sleepers and sleep until it is handed over.
+			// A thread that got here holds the lock in state 2 afterwards, it can not
+			// tell whether other threads still sleep.
+			void		lock_sleep()
+			{
+				while (_state.exchange(SLEEPERS) != UNLOCKED)
+					_state.wait(SLEEPERS);
+			}
+
+			atom_u32	_state;
+			atom_s32	_spins;
+		};
+
+		/**
+		* Condition variable on a sequence counter.
+		* wait() reads the counter while the mutex is held, unlocks and sleeps until
+		* notify_one() or notify_all() moved the counter on. Spurious wake-ups are
+		* possible, always wait in a loop on the predicate:
+		*
+		*     mutex::guard g(m);
+		*     while (!ready)
+		*         cv.wait(m);
+		*
+		* A count of waiters lets notify skip the wake-up syscall when nobody waits.
+		*/
+		class condvar
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						condvar()												{ _seq.store_relaxed(0); _waiters.store_relaxed(0); }
+
+			/**
+			* Unlock 'm', sleep until notified and lock 'm' again, 'm' must be locked.
+			*/
+			void		wait(mutex& m)
+			{
+				_waiters.incr();
+				u32 const seq = _seq.get();
+				m.unlock();
+				_seq.wait(seq);
+				_waiters.decr();
+				relock(m);
+			}
+
+			/**
+			* Same as wait(), gives up after 'timeout_ns' nanoseconds.
+			* @return false on time-out, 'm' is locked again in both cases
+			*/
+			bool		wait_for(mutex& m, u64 timeout_ns)
+			{
+				_waiters.incr();
+				u32 const seq = _seq.get();
+				m.unlock();
+				bool const notified = _seq.wait_for(seq, timeout_ns);
+				_waiters.decr();
+				relock(m);
+				return notified;
+			}
+
+			void		notify_one()
+			{
+				_seq.incr();
+				if (_waiters.get() != 0)
+					_seq.notify_one();
+			}
+
+			void		notify_all()
+			{
+				_seq.incr();
+				if (_waiters.get() != 0)
+					_seq.notify_all();
+			}
+
+		protected:
+			// Woken waiters usually find the mutex taken by the notifier, skip the
+			// spinning and go to sleep on it directly
+			static void	relock(mutex& m)
+			{
+				if (!m.try_lock())
+					m.lock_sleep();
+			}
+
+			atom_u32	_seq;
+			atom_u32	_waiters;
+		};
+
+	} // namespace atomic
+} // namespace ncore
+
+
+#endif // __CMULTICORE_MUTEX_H__
@@ -0,0 +1,229 @@
+#ifndef __CMULTICORE_PERCPU_H__
+#define __CMULTICORE_PERCPU_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "catomic/private/c_compiler.h"
+#include "catomic/private/c_cpu.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+
+// Restartable sequences are used on X86-64 Linux, define D_PERCPU_ATOMIC to
+// always use the atomic fallback. ThreadSanitizer builds use the fallback as
+// well, the sanitizer can not see the ordering an rseq sequence gives.
+#if defined(__SANITIZE_THREAD__) && !defined(D_PERCPU_ATOMIC)
+	#define D_PERCPU_ATOMIC
+#elif defined(__has_feature)
+	#if __has_feature(thread_sanitizer) && !defined(D_PERCPU_ATOMIC)
+		#define D_PERCPU_ATOMIC
+	#endif
+#endif
+#if defined(TARGET_LINUX) && defined(__x86_64__) && !defined(D_PERCPU_ATOMIC)
+	#define D_PERCPU_RSEQ
+	#include "catomic/private/c_percpu_rseq_x86_linux64.h"
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		//-------------------------------------------------------------------------------------
+		// per-cpu operations
+		// Data is laid out with one slot per cpu and a thread only changes the slot of
+		// the cpu it runs on. With restartable sequences (Linux rseq) an operation is
+		// a plain instruction sequence that the kernel restarts when the thread is
+		// preempted or migrated halfway, so there is no lock prefix at all. Without
+		// rseq the same functions fall back to atomic operations on the slot.
+		//
+		// An operation is attempted on the slot of 'cpu', which the caller takes from
+		// percpu_cpu() just before. percpu_restart means the thread left that cpu or
+		// was interrupted, take percpu_cpu() again and retry:
+		//
+		//     u32 cpu;
+		//     do { cpu = percpu_cpu(); } while (percpu_add(cpu, &slots[cpu], 1) == percpu_restart);
+		//
+		// The slot array needs percpu_slots() entries. All threads have to go through
+		// these functions, whether rseq is used is decided once per process. A thread
+		// that the kernel refuses to register runs the atomic fallback on the extra
+		// last slot, which no rseq sequence ever touches.
+		//-------------------------------------------------------------------------------------
+		enum
+		{
+			percpu_ok = 0,				///< the operation was applied
+			percpu_fail = 1,			///< compare failed or the list is empty
+			percpu_restart = -1,		///< the thread was moved off the cpu, retry
+		};
+
+		struct percpu_node
+		{
+			percpu_node*	next;
+		};
+
+		/**
+		* Head of one cpu's singly linked list.
+		* 'lock' only serializes the atomic fallback, with rseq nothing else can run on
+		* the cpu while a sequence is busy with the list.
+		*/
+		struct percpu_list
+		{
+			percpu_node*	head;
+			atom_flag		lock;
+
+							percpu_list() : head(NULL)						{ }
+		};
+
+		/**
+		* Number of slots per-cpu data needs, one per cpu and the shared one.
+		*/
+		inline u32		percpu_slots()
+		{
+			static u32 const n = cpu_current::sCount() + 1;
+			return n;
+		}
+
+		/**
+		* Register the calling thread for restartable sequences.
+		* Optional, the first percpu_cpu() of a thread registers it as well. There is
+		* nothing to do when the C library already registered the thread (glibc 2.35+).
+		* @return true when the calling thread's per-cpu operations use rseq
+		*/
+		inline bool		percpu_register_thread()
+		{
+#if defined(D_PERCPU_RSEQ)
+			return cpu_rseq::sRegistered();
+#else
+			return false;
+#endif
+		}
+
+		/**
+		* Unregister the calling thread, only needed when it registered itself and its
+		* thread local storage goes away before the thread exits.
+		*/
+		inline void		percpu_unregister_thread()
+		{
+#if defined(D_PERCPU_RSEQ)
+			cpu_rseq::sUnregister();
+#endif
+		}
+
+		/**
+		* @return true when the process uses rseq, false when every thread uses the atomic fallback
+		*/
+		inline bool		percpu_rseq_available()
+		{
+#if defined(D_PERCPU_RSEQ)
+			return cpu_rseq::sMode() != cpu_rseq::MODE_NONE;
+#else
+			return false;
+#endif
+		}
+
+		/**
+		* @return true when the calling thread's per-cpu operations use rseq, false for the atomic fallback
+		*/
+		inline bool		percpu_rseq()
+		{
+#if defined(D_PERCPU_RSEQ)
+			return cpu_rseq::sRegistered();
+#else
+			return false;
+#endif
+		}
+
+		/**
+		* Cpu the calling thread runs on, the slot for the next operation.
+		* The shared last slot when the process uses rseq but this thread could not
+		* register.
+		*/
+		inline u32		percpu_cpu()
+		{
+#if defined(D_PERCPU_RSEQ)
+			if (percpu_rseq())
+				return cpu_rseq::sCpu();
+			if (percpu_rseq_available())
+				return percpu_slots() - 1;
+#endif
+			return cpu_current::sIndex();
+		}
+
+		/**
+		* Add 'count' to the slot of 'cpu'.
+		* @return percpu_ok or percpu_restart
+		*/
+		inline s32		percpu_add(u32 cpu, atom_s64* v, s64 count)
+		{
+#if defined(D_PERCPU_RSEQ)
+			if (percpu_rseq())
+				return cpu_rseq::sAdd(cpu, (s64*)v, count);
+#endif
+			v->add(count);
+			return percpu_ok;
+		}
+
+		/**
+		* Replace the slot of 'cpu' with 'desired' when it holds 'expected'.
+		* @return percpu_ok, percpu_fail or percpu_restart
+		*/
+		inline s32		percpu_cmpxchg(u32 cpu, atom_s64* v, s64 expected, s64 desired)
+		{
+#if defined(D_PERCPU_RSEQ)
+			if (percpu_rseq())
+				return cpu_rseq::sCmpxchg(cpu, (s64*)v, expected, desired);
+#endif
+			return v->cas(expected, desired) ? percpu_ok : percpu_fail;
+		}
+
+		/**
+		* Push 'node' on the list of 'cpu'.
+		* @return percpu_ok or percpu_restart
+		*/
+		inline s32		percpu_push(u32 cpu, percpu_list* list, percpu_node* node)
+		{
+#if defined(D_PERCPU_RSEQ)
+			if (percpu_rseq())
+			{
+				s32 r;
+				do
+				{
+					percpu_node* const head = *(percpu_node* volatile*)&list->head;
+					node->next = head;
+					r = cpu_rseq::sCmpxchg(cpu, (s64*)&list->head, (s64)(xsize_t)head, (s64)(xsize_t)node);
+				} while (r == percpu_fail);
+				return r;
+			}
+#endif
+			backoff::pause delay;
+			while (list->lock.test_and_set())
+				delay.wait();
+			node->next = list->head;
+			list->head = node;
+			list->lock.clear();
+			return percpu_ok;
+		}
+
+		/**
+		* Pop the first node from the list of 'cpu'.
+		* @return percpu_ok, percpu_fail when the list is empty, or percpu_restart
+		*/
+		inline s32		percpu_pop(u32 cpu, percpu_list* list, percpu_node*& node)
+		{
+#if defined(D_PERCPU_RSEQ)
+			if (percpu_rseq())
+				return cpu_rseq::sPop(cpu, (void**)&list->head, (void**)&node);
+#endif
+			backoff::pause delay;
+			while (list->lock.test_and_set())
+				delay.wait();
+			node = list->head;
+			if (node != NULL)
+				list->head = node->next;
+			list->lock.clear();
+			return node != NULL ? percpu_ok : percpu_fail;
+		}
+	}
+}
+
+#endif // __CMULTICORE_PERCPU_H__
@@ -20,12 +20,13 @@ namespace ncore
 	{
 		/**
 		* Multi-reader, multi-writer lock-free queue.
+		* @tparam B backoff policy applied when a cas fails, @see backoff
 		*/
-		template <typename T>
+		template <typename T, class B = backoff::standard>
 		class queue
 		{
 		public:
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 4)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 			/**
 			* Constructor.
@@ -120,6 +121,27 @@ namespace ncore
 				return mFifo.inside(cursor);
 			}
 
+			/**
+			* Enable or disable tracking of the deepest the queue has been.
+			*/
+			void			track_high_water(bool enable)
+			{
+				mFifo.track_high_water(enable);
+			}
+
+			/**
+			* Largest number of items in the queue after a push since the last reset_high_water()
+			*/
+			u32				high_water() const
+			{
+				return mFifo.high_water();
+			}
+
+			void			reset_high_water()
+			{
+				mFifo.reset_high_water();
+			}
+
 			// ---- PUSH interface ----
 
 			/**
@@ -130,7 +152,7 @@ namespace ncore
 			T*				push_begin()
 			{
 				u32 i;
-				u8 *p = mPool.get(i);
+				u8 *p = mPool.get<B>(i);
 				if (unlikely(!p))
 					return 0;
 				mRef[i].set(1);
@@ -160,7 +182,7 @@ namespace ncore
 
 				mRef[i].incr();
 
-				bool fp = mFifo.push(i, outCursor);
+				bool fp = mFifo.ipush<B>(i, outCursor);
 				ASSERTS(fp, "ncore::atomic::queue<T>: Error, state is corrupted!");
 			}
 
@@ -181,7 +203,7 @@ namespace ncore
 				// transaction.
 
 				u32 i;
-				u8 *p = mPool.get(i);
+				u8 *p = mPool.get<B>(i);
 				if (unlikely(!p))
 					return false;
 
@@ -193,7 +215,7 @@ namespace ncore
 
 				*(T *)p = inData;
 
-				bool fp = mFifo.push(i, outCursor);
+				bool fp = mFifo.ipush<B>(i, outCursor);
 				ASSERTS(fp, "ncore::atomic::queue<T>: Error, state is corrupted!");
 
 				return true;
@@ -215,7 +237,7 @@ namespace ncore
 			T*				pop_begin()
 			{
 				u32 i, r;
-				if (!mFifo.pop(i, r))
+				if (!mFifo.ipop<B>(i, r))
 					return 0;
 				release(r);
 				return (T *) mPool.i2c(i);
@@ -242,7 +264,7 @@ namespace ncore
 				// Open coded pop_begin() -> copy -> pop_finish() transaction.
 
 				u32 i, r;
-				if (!mFifo.pop(i, r))
+				if (!mFifo.ipop<B>(i, r))
 					return false;
 
 				release(r);
@@ -275,7 +297,7 @@ namespace ncore
 			void			release(u32 i)
 			{
 				if (!mRef[i].decr_test())
-					mPool.put(i);
+					mPool.put<B>(i);
 			}
 
 			alloc_t*	mAllocator;
@@ -285,8 +307,8 @@ namespace ncore
 		};
 
 
-		template <typename T>
-		bool		queue<T>::init(alloc_t* allocator, u32 size)
+		template <typename T, class B>
+		bool		queue<T, B>::init(alloc_t* allocator, u32 size)
 		{
 			mAllocator = allocator;
 
@@ -325,8 +347,8 @@ namespace ncore
 			return true;
 		}
 
-		template <typename T>
-		bool		queue<T>::init(fifo::link* fifo_chain, u32 fifo_size, lifo::link* lifo_chain, u32 lifo_size, xbyte *mempool_buf, u32 mempool_buf_size, u32 mempool_buf_esize, atom_s32* mempool_buf_eref)
+		template <typename T, class B>
+		bool		queue<T, B>::init(fifo::link* fifo_chain, u32 fifo_size, lifo::link* lifo_chain, u32 lifo_size, xbyte *mempool_buf, u32 mempool_buf_size, u32 mempool_buf_esize, atom_s32* mempool_buf_eref)
 		{
 			ASSERT(lifo_size == fifo_size);
 
@@ -10,6 +10,7 @@
 
 #include "catomic/private/c_allocator.h"
 #include "catomic/private/c_compiler.h"
+#include "catomic/c_atomic.h"
 #include "catomic/c_barrier.h"
 
 namespace ncore
@@ -40,19 +41,27 @@ namespace ncore
 
 			node*			_items;
 			u32				_size;
+			bool			_track_high_water;
 
 			// R/W access by the reader
 			// R/O access by the writer
-			vo_u32			_popi;
+			// Reader and writer state live on separate cache lines
+			DCORE_CACHELINE_ALIGN vo_u32	_popi;
 			T*				_pop_transaction;
 
 			// R/W access by the writer
 			// R/O access by the reader
-			vo_u32			_pushi;
+			DCORE_CACHELINE_ALIGN vo_u32	_pushi;
 			T*				_push_transaction;
+			atom_u32		_high_water;		// optional, written by the writer only
+
+			// Acquire the index owned by the other side, so that the item
+			// reads/writes it guards are not hoisted above it.
+			u32			popi() const										{ return read_u32_acquire((u32 volatile*)&_popi); }
+			u32			pushi() const										{ return read_u32_acquire((u32 volatile*)&_pushi); }
 
 		public:
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 4)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 			/**
 			* Construct an invalid ring, use init() to initialize a valid ring.
@@ -62,6 +71,7 @@ namespace ncore
 				_allocator = NULL;
 				_items = NULL;
 				_size = 0;
+				_track_high_water = false;
 				_popi = 0;
 				_pop_transaction = NULL;
 				_pushi = 0;
@@ -150,20 +160,31 @@ namespace ncore
 			* Get number of items in the ring
 			* @return number of items in the ring
 			*/
-			u32			count() const										{ return (_pushi - _popi); }
-			u32			size()   const										{ return (_pushi - _popi); }
+			u32			count() const										{ return (pushi() - popi()); }
+			u32			size()   const										{ return (pushi() - popi()); }
 
 			/**
 			* Get available room.
 			* @return number that can be ring
 			*/
-			u32			room() const										{ return _size - (_pushi - _popi); }
+			u32			room() const										{ return _size - (pushi() - popi()); }
 
 			/**
 			* Check if ring is empty.
 			* @return true if ring is empty, false otherwise.
 			*/
-			bool		empty() const										{ return _popi == _pushi; }
+			bool		empty() const										{ return popi() == pushi(); }
+
+			/**
+			* Enable or disable tracking of the largest number of items seen after a push.
+			*/
+			void		track_high_water(bool enable)						{ _track_high_water = enable; }
+
+			/**
+			* Largest number of items seen after a push since the last reset_high_water().
+			*/
+			u32			high_water() const									{ return _high_water.load_relaxed(); }
+			void		reset_high_water()									{ _high_water.store_relaxed(0); }
 
 			// -------- Writer interface ---------
 			/**
@@ -174,7 +195,7 @@ namespace ncore
 			{
 				ASSERT(_push_transaction == NULL);
 
-				u32 h = _popi;
+				u32 h = popi();
 				u32 t0 = _pushi;
 				u32 t1 = (t0 + 1) % _size;
 
@@ -204,14 +225,16 @@ namespace ncore
 				ASSERT(_push_transaction != NULL);
 
 				u32 t0 = _pushi;
+				u32 t1 = (t0 + 1) % _size;
 				ASSERT(_push_transaction == &_items[t0].item);
 
-				// Barrier is needed to make sure that item is updated
+				// Release is needed to make sure that item is updated
 				// before it's made available to the reader.
-				barrier::memw();
-
-				_pushi = (t0 + 1) % _size;
+				write_u32_release(&_pushi, t1);
 				_push_transaction = NULL;
+
+				if (_track_high_water)
+					_high_water.fetch_max((t1 + _size - popi()) % _size);
 			}
 
 			/**
@@ -224,7 +247,7 @@ namespace ncore
 			{
 				ASSERT(_push_transaction == NULL);
 
-				u32 h = _popi;
+				u32 h = popi();
 				u32 t0 = _pushi;
 				u32 t1 = (t0 + 1) % _size;
 
@@ -233,11 +256,12 @@ namespace ncore
 
 				_items[t0].item = data;
 
-				// Barrier is needed to make sure that item is updated 
+				// Release is needed to make sure that item is updated 
 				// before it's made available to the reader
-				barrier::memw();
+				write_u32_release(&_pushi, t1);
 
-				_pushi = t1;
+				if (_track_high_water)
+					_high_water.fetch_max((t1 + _size - popi()) % _size);
 				return true;
 			}
 
@@ -252,7 +276,7 @@ namespace ncore
 			T*			pop_begin()
 			{
 				u32 h = _popi;
-				if (h == _pushi)
+				if (h == pushi())
 					return 0;
 
 				_pop_transaction = &_items[h].item;
@@ -277,12 +301,10 @@ namespace ncore
 			{
 				ASSERT(_pop_transaction != NULL);
 
-				// Barrier is needed to make sure that we finished reading items 
+				// Release is needed to make sure that we finished reading items 
 				// before moving the head
-				barrier::comp();
-
 				u32 h = _popi;
-				_popi = (h + 1) % _size;
+				write_u32_release(&_popi, (h + 1) % _size);
 
 				ASSERT(_push_transaction == &_items[h].item);
 				_pop_transaction = NULL;
@@ -298,17 +320,16 @@ namespace ncore
 			{
 				ASSERT(_pop_transaction == NULL);
 
-				u32 t = _pushi;
+				u32 t = pushi();
 				u32 h = _popi;
 				if (h == t)
 					return false;
 
 				data = _items[h].item;
 
-				// Barrier is needed to make sure that we finished
+				// Release is needed to make sure that we finished
 				// reading the item before moving the head.
-				barrier::comp();
-				_popi = (h + 1) % _size;
+				write_u32_release(&_popi, (h + 1) % _size);
 				return true;
 			}
 
@@ -320,7 +341,7 @@ namespace ncore
 			bool		peek(T &data) const
 			{
 				u32 h = _popi;
-				if (h == _pushi)
+				if (h == pushi())
 					return false;
 				*data = _items[h];
 				return true;
@@ -0,0 +1,417 @@
+#ifndef __CMULTICORE_SPINLOCK_H__
+#define __CMULTICORE_SPINLOCK_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_debug.h"
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/private/c_cpu.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_bitset.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		//-------------------------------------------------------------------------------------
+		// spinlocks
+		// For short critical sections next to the lock-free containers, a waiter never
+		// enters the kernel. The ticket, MCS and CLH locks grant the lock in arrival
+		// order (FIFO), so there is no thundering herd on release.
+		//
+		//   ticket_lock  one fetch_add to enter, waiters all read the same word
+		//   mcs_lock     queue of caller provided nodes, every waiter spins on its own
+		//   clh_lock     implicit queue, every waiter spins on its predecessor's node
+		//   rw_spinlock  reader-writer lock, readers mark a per-cpu slot (BRAVO)
+		//
+		// BACKOFF is called while waiting, the default spins with growing pauses and
+		// then yields, so the locks keep working with more threads than cores. A
+		// preempted lock holder or waiter stalls everyone queued behind it, use an OS
+		// mutex when critical sections can block.
+		//-------------------------------------------------------------------------------------
+
+		/**
+		* Ticket lock.
+		* lock() takes a ticket with fetch_add and waits until it is served, unlock()
+		* serves the next ticket. The two counters are on separate cache lines so that
+		* arriving threads do not disturb the waiters.
+		*/
+		template <class BACKOFF = backoff::exponential_yield<> >
+		class ticket_lock
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						ticket_lock()											{ _next.store_relaxed(0); _serving.store_relaxed(0); }
+
+			void		lock()
+			{
+				u32 const ticket = _next.fetch_add(1);
+				BACKOFF delay;
+				while (_serving.load_acquire() != ticket)
+					delay.wait();
+			}
+
+			/**
+			* Take the lock when it is free and nobody is waiting.
+			*/
+			bool		try_lock()
+			{
+				u32 const serving = _serving.load_acquire();
+				return _next.cas(serving, serving + 1);
+			}
+
+			void		unlock()												{ _serving.store_release(_serving.load_relaxed() + 1); }
+			bool		is_locked() const										{ return _next.load_relaxed() != _serving.load_relaxed(); }
+
+			/**
+			* Holds the lock for the lifetime of the guard.
+			*/
+			class guard
+			{
+			public:
+						guard(ticket_lock& l) : _lock(l)						{ _lock.lock(); }
+						~guard()												{ _lock.unlock(); }
+
+			protected:
+				ticket_lock&	_lock;
+			};
+
+		protected:
+			atom_padded<atom_u32>	_next;
+			atom_padded<atom_u32>	_serving;
+		};
+
+		/**
+		* MCS queue lock (Mellor-Crummey and Scott).
+		* Every acquisition brings a node, typically on the caller's stack, that stays
+		* alive until unlock(). A waiter spins on its own node and the holder hands the
+		* lock over by writing to its successor's node only, so one release touches one
+		* remote cache line no matter how many threads wait.
+		*/
+		template <class BACKOFF = backoff::exponential_yield<> >
+		class mcs_lock
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			struct DCORE_CACHELINE_ALIGN node
+			{
+				atom<node*>		next;
+				atom_u32		locked;
+			};
+
+						mcs_lock()												{ _tail.store(NULL); }
+
+			void		lock(node& n)
+			{
+				n.next.store(NULL);
+				n.locked.store_relaxed(1);
+				node* const pred = _tail.exchange(&n);
+				if (pred == NULL)
+					return;
+				pred->next.store(&n);
+				BACKOFF delay;
+				while (n.locked.load_acquire() != 0)
+					delay.wait();
+			}
+
+			/**
+			* Take the lock when it is free and nobody is waiting.
+			*/
+			bool		try_lock(node& n)
+			{
+				n.next.store(NULL);
+				n.locked.store_relaxed(1);
+				node* expected = NULL;
+				return _tail.compare_exchange(expected, &n);
+			}
+
+			void		unlock(node& n)
+			{
+				node* succ = n.next.load();
+				if (succ == NULL)
+				{
+					node* expected = &n;
+					if (_tail.compare_exchange(expected, (node*)NULL))
+						return;
+					// A successor swapped the tail but did not link itself yet
+					BACKOFF delay;
+					while ((succ = n.next.load()) == NULL)
+						delay.wait();
+				}
+				succ->locked.store_release(0);
+			}
+
+			bool		is_locked() const										{ return _tail.load() != NULL; }
+
+			/**
+			* Holds the lock for the lifetime of the guard, the node is part of the guard.
+			*/
+			class guard
+			{
+			public:
+						guard(mcs_lock& l) : _lock(l)							{ _lock.lock(_node); }
+						~guard()												{ _lock.unlock(_node); }
+
+			protected:
+				mcs_lock&	_lock;
+				node		_node;
+			};
+
+		protected:
+			DCORE_CACHELINE_ALIGN atom<node*>	_tail;
+		};
+
+		/**
+		* CLH queue lock (Craig, Landin and Hagersten).
+		* lock() swaps the thread's node into the tail and spins on the node it got
+		* back, unlock() clears its own node and takes over the predecessor's node for
+		* the next acquisition. Nodes therefore move between threads, they all live in
+		* the lock: a thread claims one with attach() into a handle that it keeps for
+		* as long as it uses the lock, at most THREADS threads at the same time.
+		* There is no try_lock(), a node in the queue can not be taken back.
+		*/
+		template <u32 THREADS = 64, class BACKOFF = backoff::exponential_yield<> >
+		class clh_lock
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			struct DCORE_CACHELINE_ALIGN node
+			{
+				atom_u32		locked;
+			};
+
+			struct handle
+			{
+				u32				slot;
+				node*			mine;
+				node*			pred;
+
+								handle() : slot(THREADS), mine(NULL), pred(NULL)	{ }
+			};
+
+						clh_lock()
+			{
+				for (u32 i = 0; i <= THREADS; ++i)
+					_nodes[i].locked.store_relaxed(0);
+				for (u32 i = 0; i < THREADS; ++i)
+					_slots[i] = &_nodes[i];
+				_tail.store(&_nodes[THREADS]);
+			}
+
+			/**
+			* Claim a node for the calling thread.
+			* @return false when THREADS handles are attached already
+			*/
+			bool		attach(handle& h)
+			{
+				u32 slot;
+				if (!_threads.acquire_any(slot))
+					return false;
+				h.slot = slot;
+				h.mine = _slots[slot];
+				return true;
+			}
+
+			/**
+			* Give the node back, the handle must not hold the lock.
+			*/
+			void		detach(handle& h)
+			{
+				ASSERT(h.slot < THREADS);
+				_slots[h.slot] = h.mine;
+				_threads.release(h.slot);
+				h.slot = THREADS;
+				h.mine = NULL;
+			}
+
+			void		lock(handle& h)
+			{
+				ASSERT(h.slot < THREADS);
+				h.mine->locked.store_relaxed(1);
+				h.pred = _tail.exchange(h.mine);
+				BACKOFF delay;
+				while (h.pred->locked.load_acquire() != 0)
+					delay.wait();
+			}
+
+			void		unlock(handle& h)
+			{
+				h.mine->locked.store_release(0);
+				h.mine = h.pred;
+			}
+
+			bool		is_locked() const										{ return _tail.load()->locked.load_relaxed() != 0; }
+
+			/**
+			* Holds the lock for the lifetime of the guard, 'h' must be attached.
+			*/
+			class guard
+			{
+			public:
+						guard(clh_lock& l, handle& h) : _lock(l), _handle(h)	{ _lock.lock(_handle); }
+						~guard()												{ _lock.unlock(_handle); }
+
+			protected:
+				clh_lock&	_lock;
+				handle&		_handle;
+			};
+
+		protected:
+			node					_nodes[THREADS + 1];
+			node*					_slots[THREADS];
+			DCORE_CACHELINE_ALIGN atom<node*>	_tail;
+			atomic_bitset<THREADS>	_threads;
+		};
+
+
+		/**
+		* Reader-writer spinlock with per-cpu reader slots (BRAVO, Dice and Kogan).
+		* While the lock is reader biased a reader only increments the slot of the cpu
+		* it runs on, readers on different cpus never write the same cache line. A
+		* writer takes the underlying lock, revokes the bias and waits for the slots to
+		* drain. Until INHIBIT readers have gone through the underlying lock after
+		* that, readers stay on the slow path, so frequent writers do not pay a drain
+		* on every write. The underlying lock prefers writers, a waiting writer stops
+		* new readers.
+		* read_lock() returns a token that has to be passed to read_unlock(), the
+		* thread can migrate to another cpu in between.
+		* @tparam SLOTS number of reader slots, power of two, ideally >= number of cpus
+		*/
+		template <u32 SLOTS = 64, u32 INHIBIT = 64, class BACKOFF = backoff::exponential_yield<> >
+		class rw_spinlock
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						rw_spinlock()
+			{
+				_state.store_relaxed(0);
+				_bias.store_relaxed(1);
+				_inhibit.store_relaxed(0);
+				for (u32 i = 0; i < SLOTS; ++i)
+					_readers[i].store_relaxed(0);
+			}
+
+			u32			read_lock()
+			{
+				if (_bias.load_relaxed() != 0)
+				{
+					u32 const slot = cpu_current::sIndex() & (SLOTS - 1);
+					// Both sequentially consistent, a writer revokes the bias and then
+					// reads the slots in the opposite order
+					_readers[slot].incr();
+					if (_bias.get() != 0)
+						return slot;
+					_readers[slot].decr();
+				}
+
+				BACKOFF delay;
+				for (;;)
+				{
+					u32 const s = _state.load_relaxed();
+					if ((s & WRITER) == 0 && _state.cas(s, s + 1))
+						break;
+					delay.wait();
+				}
+				if (_bias.load_relaxed() == 0 && _inhibit.fetch_sub(1) == 1)
+					_bias.set(1);
+				return SLOW;
+			}
+
+			void		read_unlock(u32 token)
+			{
+				if (token != SLOW)
+					_readers[token].decr();
+				else
+					_state.decr();
+			}
+
+			void		write_lock()
+			{
+				BACKOFF delay;
+				while ((_state.fetch_or(WRITER) & WRITER) != 0)
+				{
+					while ((_state.load_relaxed() & WRITER) != 0)
+						delay.wait();
+				}
+				while (_state.load_acquire() != WRITER)
+					delay.wait();
+
+				if (_bias.load_relaxed() != 0)
+				{
+					_bias.exchange(0);
+					for (u32 i = 0; i < SLOTS; ++i)
+					{
+						while (_readers[i].get() != 0)
+							delay.wait();
+					}
+					_inhibit.store_relaxed(INHIBIT);
+				}
+			}
+
+			void		write_unlock()											{ _state.store_release(0); }
+
+			/**
+			* @return true while new readers take the per-cpu slots
+			*/
+			bool		is_read_biased() const									{ return _bias.load_relaxed() != 0; }
+
+			/**
+			* Holds a read lock for the lifetime of the guard.
+			*/
+			class read_guard
+			{
+			public:
+						read_guard(rw_spinlock& l) : _lock(l)					{ _token = _lock.read_lock(); }
+						~read_guard()											{ _lock.read_unlock(_token); }
+
+			protected:
+				rw_spinlock&	_lock;
+				u32				_token;
+			};
+
+			/**
+			* Holds the write lock for the lifetime of the guard.
+			*/
+			class write_guard
+			{
+			public:
+						write_guard(rw_spinlock& l) : _lock(l)					{ _lock.write_lock(); }
+						~write_guard()											{ _lock.write_unlock(); }
+
+			protected:
+				rw_spinlock&	_lock;
+			};
+
+		protected:
+			enum
+			{
+				WRITER = 0x80000000,
+				SLOW = 0xffffffff,
+			};
+
+			typedef char	check_slots[((SLOTS & (SLOTS - 1)) == 0 && SLOTS > 0) ? 1 : -1];
+
+			// Read by every reader, only written when the bias changes, so it does
+			// not share a line with the counters below
+			atom_padded<atom_u32>				_bias;
+			// Reader count and writer bit of the underlying lock
+			DCORE_CACHELINE_ALIGN atom_u32		_state;
+			atom_s32							_inhibit;
+			atom_padded<atom_u32>				_readers[SLOTS];
+		};
+
+	} // namespace atomic
+} // namespace ncore
+
+
+#endif // __CMULTICORE_SPINLOCK_H__
@@ -20,8 +20,9 @@ namespace ncore
 	{
 		/**
 		* Multi-reader, multi-writer lock-free stack.
+		* @tparam B backoff policy applied when a cas fails, @see backoff
 		*/
-		template <typename T>
+		template <typename T, class B = backoff::standard>
 		class stack
 		{
 		private:
@@ -29,7 +30,7 @@ namespace ncore
 			lifo		_lifo;
 
 		public:
-			DCORE_CLASS_NEW_DELETE(sGetAllocator, 4)
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
 
 						stack() {}
 
@@ -108,14 +109,18 @@ namespace ncore
 			* @return pointer to the beginning if the item, or 0
 			* if there is no space.
 			*/
-			T*			push_begin()												{ return (T *) _items.get(); }
+			T*			push_begin()
+			{
+				u32 i;
+				return (T *) _items.get<B>(i);
+			}
 
 			/**
 			* Cancel push transaction.
 			* Item must have been obtained via push_begin().
 			* @param[in] item pointer to an item
 			*/
-			void		push_cancel(T *p)											{ _items.put((u8 *) p); }
+			void		push_cancel(T *p)											{ _items.put<B>(_items.c2i((u8 *) p)); }
 
 			/**
 			* Commit push transaction. Push an item onto the stack.
@@ -125,7 +130,7 @@ namespace ncore
 			void		push_commit(T *p)
 			{
 				u32 i = _items.c2i((u8 *) p);
-				bool lp = _lifo.push(i);
+				bool lp = _lifo.ipush<B>(i);
 				ASSERTS(lp, "xatomic::stack<T>: Error, state is corrupted!");
 			}
 
@@ -140,14 +145,14 @@ namespace ncore
 				// transaction
 
 				u32 i;
-				T *p = (T *) _items.get(i);
+				T *p = (T *) _items.get<B>(i);
 
 				if (unlikely(!p))
 					return false;
 
 				*p = inData;
 
-				bool lp = _lifo.push(i);
+				bool lp = _lifo.ipush<B>(i);
 				ASSERTS(lp, "xatomic::stack<T>: Error, state is corrupted!");
 
 				return true;
@@ -162,7 +167,7 @@ namespace ncore
 			T*			pop_begin()
 			{
 				u32 i;
-				if (_lifo.pop(i))
+				if (_lifo.ipop<B>(i))
 					return (T*) _items.i2c(i);
 				return 0;
 			}
@@ -173,7 +178,7 @@ namespace ncore
 			*/
 			void		pop_finish(T *p)
 			{
-				_items.put((u8 *) p); 
+				_items.put<B>(_items.c2i((u8 *) p));
 			}
 
 			/**
@@ -188,13 +193,13 @@ namespace ncore
 				// transaction.
 
 				u32 i;
-				if (!_lifo.pop(i))
+				if (!_lifo.ipop<B>(i))
 					return false;
 
 				T *p = (T *) _items.i2c(i);
 				outData = *p;
 
-				_items.put(i);
+				_items.put<B>(i);
 				return true;
 			}
 
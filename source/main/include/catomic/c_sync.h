@@ -0,0 +1,310 @@
+#ifndef __CMULTICORE_SYNC_H__
+#define __CMULTICORE_SYNC_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_debug.h"
+#include "ccore/c_allocator.h"
+
+#include "catomic/private/c_allocator.h"
+#include "catomic/private/c_compiler.h"
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+
+namespace ncore
+{
+	namespace atomic
+	{
+		//-------------------------------------------------------------------------------------
+		// thread synchronization: latch, cyclic_barrier and semaphore
+		// Waiters spin for SPINS spin-wait hints and then sleep in atom_u32::wait(),
+		// futex(2) on Linux and WaitOnAddress on Windows. The wake-up syscalls are
+		// skipped when nobody sleeps.
+		//-------------------------------------------------------------------------------------
+
+		/**
+		* Single use count down latch.
+		* Threads count_down() and wait() until the count reaches zero, after that
+		* wait() returns immediately.
+		*/
+		template <u32 SPINS = 1024>
+		class latch
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						latch(u32 count)										{ _count.store_relaxed(count); _sleepers.store_relaxed(0); }
+
+			void		count_down(u32 n = 1)
+			{
+				u32 const old = _count.fetch_sub(n);
+				ASSERT(old >= n);
+				if (old == n && _sleepers.get() != 0)
+					_count.notify_all();
+			}
+
+			bool		try_wait() const										{ return _count.load_acquire() == 0; }
+
+			void		wait()
+			{
+				u32 c = _count.load_acquire();
+				if (c == 0)
+					return;
+				for (u32 i = 0; i < SPINS && c != 0; ++i)
+				{
+					barrier::pause();
+					c = _count.load_acquire();
+				}
+				// Announce the sleeper before the last look at the count, count_down()
+				// changes the count before it looks at the sleepers
+				_sleepers.incr();
+				while ((c = _count.get()) != 0)
+					_count.wait(c);
+				_sleepers.decr();
+			}
+
+			void		arrive_and_wait(u32 n = 1)
+			{
+				count_down(n);
+				wait();
+			}
+
+		protected:
+			atom_u32	_count;
+			atom_u32	_sleepers;
+		};
+
+		/**
+		* Reusable barrier for a fixed number of threads, a static combining tree.
+		* Thread 'id' arrives at leaf id / FANIN, the last thread to arrive at a node
+		* continues to its parent, and the one that completes the root ends the phase.
+		* The completing threads then release the nodes on their way back down, so a
+		* phase costs O(FANIN) traffic per node instead of all threads hitting one line.
+		* Every thread passes its own id, 0 to parties-1, to arrive_and_wait().
+		*/
+		template <u32 FANIN = 4, u32 SPINS = 1024>
+		class cyclic_barrier
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+			struct DCORE_CACHELINE_ALIGN node
+			{
+				atom_u32		count;
+				atom_u32		phase;
+				atom_u32		sleepers;
+				u32				expected;
+				u32				parent;
+
+				inline			node() : expected(0), parent(NONE)		{ }
+				DCORE_CLASS_PLACEMENT_NEW_DELETE
+			};
+
+			/**
+			* Construct an invalid barrier, use init() to initialize a valid barrier.
+			*/
+						cyclic_barrier() : _allocator(NULL), _nodes(NULL), _num_nodes(0), _parties(0)	{ }
+						~cyclic_barrier()										{ clear(); }
+
+			/**
+			* Build the tree for 'parties' threads.
+			*/
+			bool		init(alloc_t* allocator, u32 parties)
+			{
+				ASSERT(parties > 0);
+				clear();
+
+				u32 num_nodes = 0;
+				for (u32 n = parties; ; n = (n + FANIN - 1) / FANIN)
+				{
+					num_nodes += (n + FANIN - 1) / FANIN;
+					if (n <= FANIN)
+						break;
+				}
+
+				_nodes = (node*)allocator->allocate(num_nodes * sizeof(node), DCORE_CACHELINE_SIZE);
+				if (_nodes == NULL)
+					return false;
+				_allocator = allocator;
+				_num_nodes = num_nodes;
+				_parties = parties;
+				for (u32 i = 0; i < num_nodes; ++i)
+					new (&_nodes[i]) node();
+
+				// Levels are stored leaves first, every level's children are the
+				// entries of the level below
+				u32 first = 0;
+				u32 children = parties;
+				for (;;)
+				{
+					u32 const count = (children + FANIN - 1) / FANIN;
+					for (u32 i = 0; i < count; ++i)
+					{
+						u32 const end = (i + 1) * FANIN < children ? (i + 1) * FANIN : children;
+						_nodes[first + i].expected = end - i * FANIN;
+						_nodes[first + i].count.store_relaxed(end - i * FANIN);
+					}
+					if (count == 1)
+						break;
+					for (u32 i = 0; i < count; ++i)
+						_nodes[first + i].parent = first + count + i / FANIN;
+					first += count;
+					children = count;
+				}
+				return true;
+			}
+
+			void		clear()
+			{
+				if (_nodes == NULL)
+					return;
+				for (u32 i = 0; i < _num_nodes; ++i)
+					_nodes[i].~node();
+				_allocator->deallocate(_nodes);
+				_nodes = NULL;
+				_num_nodes = 0;
+				_parties = 0;
+			}
+
+			u32			parties() const											{ return _parties; }
+
+			/**
+			* Wait until all parties arrived.
+			* @return true for exactly one thread per phase, the one that completed it
+			*/
+			bool		arrive_and_wait(u32 id)
+			{
+				ASSERT(id < _parties);
+				return arrive(id / FANIN);
+			}
+
+		protected:
+			enum
+			{
+				NONE = 0xffffffff,
+			};
+
+			bool		arrive(u32 n)
+			{
+				node& nd = _nodes[n];
+				// The phase can not move before this thread arrived
+				u32 const phase = nd.phase.load_acquire();
+				if (nd.count.fetch_sub(1) != 1)
+				{
+					wait(nd, phase);
+					return false;
+				}
+
+				// Last one here, nobody arrives at this node before the release below
+				nd.count.store_relaxed(nd.expected);
+				bool const completed = nd.parent == NONE ? true : arrive(nd.parent);
+
+				nd.phase.exchange(phase + 1);
+				if (nd.sleepers.get() != 0)
+					nd.phase.notify_all();
+				return completed;
+			}
+
+			static void	wait(node& nd, u32 phase)
+			{
+				for (u32 i = 0; i < SPINS; ++i)
+				{
+					if (nd.phase.load_acquire() != phase)
+						return;
+					barrier::pause();
+				}
+				nd.sleepers.incr();
+				while (nd.phase.get() == phase)
+					nd.phase.wait(phase);
+				nd.sleepers.decr();
+			}
+
+			alloc_t*	_allocator;
+			node*		_nodes;
+			u32			_num_nodes;
+			u32			_parties;
+		};
+
+		/**
+		* Counting semaphore.
+		* The count goes below zero by the number of threads that committed to sleep,
+		* so acquire() and release() without contention are one fetch_sub or
+		* fetch_add. release() hands a wake-up token to every sleeper it accounts for,
+		* a sleeper consumes one token before it returns.
+		*/
+		template <u32 SPINS = 1024>
+		class semaphore
+		{
+		public:
+			DCORE_CLASS_NEW_DELETE(sGetAllocator, DCORE_CACHELINE_SIZE)
+
+						semaphore(s32 count = 0)								{ ASSERT(count >= 0); _count.store_relaxed(count); _wakeups.store_relaxed(0); }
+
+			bool		try_acquire()
+			{
+				s32 c = _count.load_relaxed();
+				while (c > 0)
+				{
+					if (_count.cas_acquire(c, c - 1))
+						return true;
+					c = _count.load_relaxed();
+				}
+				return false;
+			}
+
+			void		acquire()
+			{
+				for (u32 i = 0; i < SPINS; ++i)
+				{
+					if (try_acquire())
+						return;
+					barrier::pause();
+				}
+				if (_count.fetch_sub(1) > 0)
+					return;
+				sleep();
+			}
+
+			void		release(s32 n = 1)
+			{
+				ASSERT(n > 0);
+				s32 const old = _count.fetch_add(n);
+				if (old >= 0)
+					return;
+				s32 const wake = -old < n ? -old : n;
+				_wakeups.add((u32)wake);
+				if (wake == 1)
+					_wakeups.notify_one();
+				else
+					_wakeups.notify_all();
+			}
+
+			/**
+			* Current count, negative while threads sleep. Only a snapshot.
+			*/
+			s32			count() const											{ return _count.load_relaxed(); }
+
+		protected:
+			void		sleep()
+			{
+				for (;;)
+				{
+					u32 const w = _wakeups.load_acquire();
+					if (w == 0)
+						_wakeups.wait(0);
+					else if (_wakeups.cas_acquire(w, w - 1))
+						return;
+				}
+			}
+
+			DCORE_CACHELINE_ALIGN atom_s32		_count;
+			atom_u32							_wakeups;
+		};
+
+	} // namespace atomic
+} // namespace ncore
+
+
+#endif // __CMULTICORE_SYNC_H__
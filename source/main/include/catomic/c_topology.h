@@ -0,0 +1,132 @@
+#ifndef __CMULTICORE_TOPOLOGY_H__
+#define __CMULTICORE_TOPOLOGY_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "ccore/c_debug.h"
+
+#include "catomic/private/c_compiler.h"
+#include "catomic/private/c_cpu.h"
+#include "catomic/c_percpu.h"
+
+// Cpus with a higher index than this share the groups of (index % D_TOPOLOGY_MAX_CPUS)
+#ifndef D_TOPOLOGY_MAX_CPUS
+	#define D_TOPOLOGY_MAX_CPUS		1024
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		/**
+		* Cpu topology, which cpus share a core, a cache or a NUMA node.
+		* Read once from the OS on first use of sGet(), from /sys/devices/system/cpu
+		* on Linux and GetLogicalProcessorInformation on Windows. Where the OS can
+		* not tell, every cpu is its own core with private caches on one node.
+		*
+		* Every level partitions the cpus into groups numbered 0 to num_groups()-1 in
+		* the order of their lowest cpu, so a group number can index an array of
+		* shards directly:
+		*
+		*     shard& s = shards[topology::sGet().current_group(topology::LEVEL_L3)];
+		*
+		* distance() orders other cpus by locality, for example to pick steal targets.
+		*/
+		class topology
+		{
+		public:
+			enum
+			{
+				LEVEL_CORE = 0,		///< hardware threads of one core (SMT siblings)
+				LEVEL_L2 = 1,		///< cpus sharing a level 2 cache
+				LEVEL_L3 = 2,		///< cpus sharing a level 3 cache
+				LEVEL_NODE = 3,		///< cpus of one NUMA node
+				LEVEL_COUNT = 4,
+			};
+
+			enum
+			{
+				DISTANCE_CPU = 0,		///< the same cpu
+				DISTANCE_CORE = 1,		///< another hardware thread of the same core
+				DISTANCE_L2 = 2,		///< shares the level 2 cache
+				DISTANCE_L3 = 3,		///< shares the level 3 cache
+				DISTANCE_NODE = 4,		///< on the same NUMA node
+				DISTANCE_REMOTE = 5,	///< on another NUMA node
+			};
+
+			/**
+			* The topology of this machine, read on the first call.
+			*/
+			static topology const&	sGet();
+
+			/**
+			* Number of cpus, every cpu number the OS hands out is below it.
+			*/
+			u32			num_cpus() const										{ return mNumCpus; }
+			u32			num_nodes() const										{ return mNumGroups[LEVEL_NODE]; }
+			u32			num_groups(u32 level) const								{ ASSERT(level < LEVEL_COUNT); return mNumGroups[level]; }
+
+			/**
+			* Group of 'cpu' at 'level', below num_groups(level).
+			*/
+			u32			group(u32 cpu, u32 level) const							{ ASSERT(cpu < mNumCpus && level < LEVEL_COUNT); return mGroup[level][cpu % D_TOPOLOGY_MAX_CPUS]; }
+			u32			node(u32 cpu) const										{ return group(cpu, LEVEL_NODE); }
+
+			/**
+			* Group of the cpu the calling thread is running on, a hint like current_cpu().
+			*/
+			u32			current_group(u32 level) const;
+
+			/**
+			* How close cpu 'b' is to cpu 'a', one of the DISTANCE_ values.
+			*/
+			u32			distance(u32 a, u32 b) const
+			{
+				if (a == b)
+					return DISTANCE_CPU;
+				u32 l = 0;
+				while (l < LEVEL_COUNT && group(a, l) != group(b, l))
+					++l;
+				return DISTANCE_CORE + l;
+			}
+
+			/**
+			* Fill 'cpus' with the other cpus ordered by distance() from 'cpu', nearest
+			* first and by cpu number within one distance.
+			* @return the number of cpus written, at most 'max'
+			*/
+			u32			neighbours(u32 cpu, u32* cpus, u32 max) const;
+
+		protected:
+						topology();
+
+			void		detect();
+			void		number_groups();
+
+			typedef char	check_max_cpus[(D_TOPOLOGY_MAX_CPUS > 0 && D_TOPOLOGY_MAX_CPUS <= 0xffff) ? 1 : -1];
+
+			u32			mNumCpus;
+			u32			mNumGroups[LEVEL_COUNT];
+			u16			mGroup[LEVEL_COUNT][D_TOPOLOGY_MAX_CPUS];
+		};
+
+		/**
+		* Cpu the calling thread runs on, below topology::sGet().num_cpus().
+		* Uses the rseq cpu_id when the thread's per-cpu operations use rseq,
+		* otherwise sched_getcpu() or GetCurrentProcessorNumber(). Only a hint, the
+		* thread can migrate right after the call.
+		*/
+		inline u32		current_cpu()
+		{
+			u32 const cpu = percpu_rseq() ? percpu_cpu() : cpu_current::sIndex();
+			u32 const n = topology::sGet().num_cpus();
+			return cpu < n ? cpu : cpu % n;
+		}
+
+		inline u32		topology::current_group(u32 level) const					{ return group(current_cpu(), level); }
+	}
+}
+
+#endif // __CMULTICORE_TOPOLOGY_H__
@@ -0,0 +1,72 @@
+/**
+ * @file catomic\private\c_atomic_arm64.h
+ * AArch64 atomics for GCC and Clang, only used with D_ATOMIC_ARM64 until it has
+ * been run on AArch64.
+ * Built with -march=armv8.1-a (or later) the compiler emits the LSE instructions
+ * (ldadd, ldset, ldclr, swp, casal) for the __atomic builtins. Without LSE it falls
+ * back to ldaxr/stlxr loops, or with -moutline-atomics picks either one at runtime.
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+
+namespace ncore
+{
+	namespace atomic
+	{
+		// The cpu specific part, everything else is in c_atomic_gcc.h
+		namespace cpu_arm64
+		{
+			// 128 bit compare and exchange, on failure the current value is returned in cl:ch.
+			// LSE has a pair compare and swap (caspal), which needs even/odd register pairs.
+			// The LL/SC version writes back the value it loaded when the compare fails,
+			// a ldaxp on its own is not guaranteed to be single-copy atomic.
+			inline static bool sInterlockedCompareExchange128(volatile u64 *dest, u64 el, u64 eh, u64 &cl, u64 &ch)
+			{
+#if defined(__ARM_FEATURE_ATOMICS)
+				register u64 x0 __asm__("x0") = cl;
+				register u64 x1 __asm__("x1") = ch;
+				register u64 x2 __asm__("x2") = el;
+				register u64 x3 __asm__("x3") = eh;
+				__asm__ __volatile__("caspal %[c0], %[c1], %[e0], %[e1], %[m]"
+					: [c0] "+r"(x0), [c1] "+r"(x1), [m] "+Q"(*(volatile u128*)dest)
+					: [e0] "r"(x2), [e1] "r"(x3)
+					: "memory");
+				bool const r = (x0 == cl) && (x1 == ch);
+				cl = x0; ch = x1;
+				return r;
+#else
+				u64 ol, oh;
+				u32 fail;
+				__asm__ __volatile__(
+					"1:	ldaxp	%[ol], %[oh], %[m]\n"
+					"	cmp	%[ol], %[cl]\n"
+					"	ccmp	%[oh], %[ch], #0, eq\n"
+					"	b.ne	2f\n"
+					"	stlxp	%w[f], %[el], %[eh], %[m]\n"
+					"	cbnz	%w[f], 1b\n"
+					"	b	3f\n"
+					"2:	stlxp	%w[f], %[ol], %[oh], %[m]\n"
+					"	cbnz	%w[f], 1b\n"
+					"3:\n"
+					: [ol] "=&r"(ol), [oh] "=&r"(oh), [f] "=&r"(fail), [m] "+Q"(*(volatile u128*)dest)
+					: [cl] "r"(cl), [ch] "r"(ch), [el] "r"(el), [eh] "r"(eh)
+					: "memory", "cc");
+				bool const r = (ol == cl) && (oh == ch);
+				cl = ol; ch = oh;
+				return r;
+#endif
+			}
+
+			// Comparing with zero and writing back zero leaves memory unchanged
+			// and returns the current value.
+			inline static void sRead128(volatile u64 *src, u64 &lo, u64 &hi)
+			{
+				lo = 0; hi = 0;
+				sInterlockedCompareExchange128(src, 0, 0, lo, hi);
+			}
+		}
+
+		namespace cpu_interlocked = cpu_arm64;
+	}
+}
+
+#include "catomic/private/c_atomic_gcc.h"
@@ -0,0 +1,741 @@
+/**
+ * @file catomic\private\c_atomic_gcc.h
+ * The part of the GCC and Clang atomics that is the same on every cpu, built on the
+ * __atomic builtins which the compiler lowers to the instructions of the target.
+ * The including backend provides namespace cpu_interlocked with the 128 bit
+ * compare and exchange, which the builtins only offer through libatomic.
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+
+namespace ncore
+{
+	namespace atomic
+	{
+		// 32 and 64 bit interlocked compare and exchange functions
+		namespace cpu_gcc
+		{
+			inline static u32 sInterlockedCompareExchange(volatile u32 *dest, u32 exchange, u32 comperand)
+			{
+				__atomic_compare_exchange_n(dest, &comperand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+				return comperand;
+			}
+
+			inline static bool sInterlockedSetIfEqual(volatile u32 *dest, u32 exchange, u32 comperand)
+			{
+				return __atomic_compare_exchange_n(dest, &comperand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			// Aligned loads and stores are single-copy atomic, a seq_cst load is a plain
+			// mov on x86 and a ldar on AArch64
+			inline static u32 sRead(volatile u32 *src)
+			{
+				return __atomic_load_n(src, __ATOMIC_SEQ_CST);
+			}
+
+			inline static void sWrite(volatile u32 *src, u32 v)
+			{
+				__atomic_store_n(src, v, __ATOMIC_RELEASE);
+			}
+
+			inline static u64 sInterlockedCompareExchange64(volatile u64 *dest, u64 exchange, u64 comperand)
+			{
+				__atomic_compare_exchange_n(dest, &comperand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+				return comperand;
+			}
+
+			inline static bool sInterlockedSetIfEqual64(volatile u64 *dest, u64 exchange, u64 comperand)
+			{
+				return __atomic_compare_exchange_n(dest, &comperand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+			}
+
+			inline static u64 sRead64(volatile u64 *src)
+			{
+				return __atomic_load_n(src, __ATOMIC_SEQ_CST);
+			}
+
+			inline static void sWrite64(volatile u64 *src, u64 v)
+			{
+				__atomic_store_n(src, v, __ATOMIC_RELEASE);
+			}
+
+			// Explicitly ordered load, store and compare and swap, the order is one of
+			// the __ATOMIC_* constants. A failed compare and swap can not be a release.
+
+			template <class U, int O>
+			inline static U sReadOrdered(volatile U *src)
+			{
+				return __atomic_load_n(src, O);
+			}
+
+			template <class U, int O>
+			inline static void sWriteOrdered(volatile U *src, U v)
+			{
+				__atomic_store_n(src, v, O);
+			}
+
+			template <class U, int O, int F>
+			inline static bool sSetIfEqualOrdered(volatile U *dest, U exchange, U comperand)
+			{
+				return __atomic_compare_exchange_n(dest, &comperand, exchange, false, O, F);
+			}
+		}
+
+
+		// 32 bit signed integer
+
+		static inline s32	read_s32(s32 volatile* p)
+		{
+			return (s32)cpu_gcc::sRead((u32 volatile*)p);
+		}
+
+		static inline void	write_s32(s32 volatile* p, s32 v)
+		{
+			cpu_gcc::sWrite((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_s32(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_gcc::sInterlockedSetIfEqual((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32(volatile s32* mem, s16 ol, s16 oh, s16 nl, s16 nh)
+		{
+			u32 old = (u16)oh; old = old << 16; old = old | (u16)ol;
+			u32 n = (u16)nh; n = n << 16; n = n | (u16)nl;
+			return cpu_gcc::sInterlockedSetIfEqual((u32 volatile*)mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline s32	read_s32_relaxed(s32 volatile* p)
+		{
+			return (s32)cpu_gcc::sReadOrdered<u32, __ATOMIC_RELAXED>((u32 volatile*)p);
+		}
+
+		static inline s32	read_s32_acquire(s32 volatile* p)
+		{
+			return (s32)cpu_gcc::sReadOrdered<u32, __ATOMIC_ACQUIRE>((u32 volatile*)p);
+		}
+
+		static inline void	write_s32_relaxed(s32 volatile* p, s32 v)
+		{
+			cpu_gcc::sWriteOrdered<u32, __ATOMIC_RELAXED>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_s32_release(s32 volatile* p, s32 v)
+		{
+			cpu_gcc::sWriteOrdered<u32, __ATOMIC_RELEASE>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_s32_relaxed(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_RELAXED, __ATOMIC_RELAXED>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_acquire(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_release(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_RELEASE, __ATOMIC_RELAXED>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_acq_rel(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+
+		// 32 bit unsigned integer
+
+		static inline u32	read_u32(u32 volatile* p)
+		{
+			return cpu_gcc::sRead(p);
+		}
+
+		static inline void	write_u32(u32 volatile* p, u32 v)
+		{
+			cpu_gcc::sWrite(p, v);
+		}
+
+		static inline bool	cas_u32(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_gcc::sInterlockedSetIfEqual(mem, n, old);
+		}
+
+		static inline bool	cas_u32(volatile u32* mem, u16 ol, u16 oh, u16 nl, u16 nh)
+		{
+			u32 old = oh; old = old << 16; old = old | ol;
+			u32 n = nh; n = n << 16; n = n | nl;
+			return cpu_gcc::sInterlockedSetIfEqual(mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline u32	read_u32_relaxed(u32 volatile* p)
+		{
+			return (u32)cpu_gcc::sReadOrdered<u32, __ATOMIC_RELAXED>((u32 volatile*)p);
+		}
+
+		static inline u32	read_u32_acquire(u32 volatile* p)
+		{
+			return (u32)cpu_gcc::sReadOrdered<u32, __ATOMIC_ACQUIRE>((u32 volatile*)p);
+		}
+
+		static inline void	write_u32_relaxed(u32 volatile* p, u32 v)
+		{
+			cpu_gcc::sWriteOrdered<u32, __ATOMIC_RELAXED>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_u32_release(u32 volatile* p, u32 v)
+		{
+			cpu_gcc::sWriteOrdered<u32, __ATOMIC_RELEASE>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_u32_relaxed(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_RELAXED, __ATOMIC_RELAXED>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_acquire(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_release(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_RELEASE, __ATOMIC_RELAXED>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_acq_rel(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u32, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+
+		// 64 bit signed integer
+
+		static inline s64	read_s64(s64 volatile* p)
+		{
+			return (s64)cpu_gcc::sRead64((volatile u64*)p);
+		}
+
+		static inline void	write_s64(s64 volatile* p, s64 v)
+		{
+			cpu_gcc::sWrite64((volatile u64*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_gcc::sInterlockedSetIfEqual64((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64(volatile s64* mem, s32 ol, s32 oh, s32 nl, s32 nh)
+		{
+			u64 old = (u32)oh; old = old << 32; old = old | (u32)ol;
+			u64 n = (u32)nh; n = n << 32; n = n | (u32)nl;
+			return cpu_gcc::sInterlockedSetIfEqual64((u64 volatile*)mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline s64	read_s64_relaxed(s64 volatile* p)
+		{
+			return (s64)cpu_gcc::sReadOrdered<u64, __ATOMIC_RELAXED>((u64 volatile*)p);
+		}
+
+		static inline s64	read_s64_acquire(s64 volatile* p)
+		{
+			return (s64)cpu_gcc::sReadOrdered<u64, __ATOMIC_ACQUIRE>((u64 volatile*)p);
+		}
+
+		static inline void	write_s64_relaxed(s64 volatile* p, s64 v)
+		{
+			cpu_gcc::sWriteOrdered<u64, __ATOMIC_RELAXED>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_s64_release(s64 volatile* p, s64 v)
+		{
+			cpu_gcc::sWriteOrdered<u64, __ATOMIC_RELEASE>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64_relaxed(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_RELAXED, __ATOMIC_RELAXED>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_acquire(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_release(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_RELEASE, __ATOMIC_RELAXED>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_acq_rel(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+
+		// 64 bit unsigned integer
+
+		static inline u64	read_u64(volatile u64* p)
+		{
+			return cpu_gcc::sRead64(p);
+		}
+
+		static inline void	write_u64(volatile u64* p, u64 v)
+		{
+			cpu_gcc::sWrite64(p, v);
+		}
+
+		static inline bool	cas_u64(volatile u64* mem, u64 old, u64 n)
+		{
+			return cpu_gcc::sInterlockedSetIfEqual64(mem, n, old);
+		}
+
+		static inline bool	cas_u64(volatile u64* mem, u32 ol, u32 oh, u32 nl, u32 nh)
+		{
+			u64 old = oh; old = old << 32; old = old | ol;
+			u64 n = nh; n = n << 32; n = n | nl;
+			return cpu_gcc::sInterlockedSetIfEqual64(mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline u64	read_u64_relaxed(u64 volatile* p)
+		{
+			return (u64)cpu_gcc::sReadOrdered<u64, __ATOMIC_RELAXED>((u64 volatile*)p);
+		}
+
+		static inline u64	read_u64_acquire(u64 volatile* p)
+		{
+			return (u64)cpu_gcc::sReadOrdered<u64, __ATOMIC_ACQUIRE>((u64 volatile*)p);
+		}
+
+		static inline void	write_u64_relaxed(u64 volatile* p, u64 v)
+		{
+			cpu_gcc::sWriteOrdered<u64, __ATOMIC_RELAXED>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_u64_release(u64 volatile* p, u64 v)
+		{
+			cpu_gcc::sWriteOrdered<u64, __ATOMIC_RELEASE>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_u64_relaxed(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_RELAXED, __ATOMIC_RELAXED>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_acquire(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_release(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_RELEASE, __ATOMIC_RELAXED>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_acq_rel(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_gcc::sSetIfEqualOrdered<u64, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+
+		// 128 bit unsigned integer
+
+		static inline u128	read_u128(u128 volatile* p)
+		{
+			u128 r;
+			cpu_interlocked::sRead128((u64 volatile*)p, r.lo, r.hi);
+			return r;
+		}
+
+		static inline void	write_u128(u128 volatile* p, u128 v)
+		{
+			u64 cl = p->lo, ch = p->hi;
+			while (!cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)p, v.lo, v.hi, cl, ch)) { }
+		}
+
+		static inline bool	cas_u128(u128 volatile* mem, u128 old, u128 n)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, n.lo, n.hi, old.lo, old.hi);
+		}
+
+		static inline bool	cas_u128(u128 volatile* mem, u64 ol, u64 oh, u64 nl, u64 nh)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, nl, nh, ol, oh);
+		}
+
+		static inline bool	compare_exchange_u128(u128 volatile* mem, u128& expected, u128 n)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, n.lo, n.hi, expected.lo, expected.hi);
+		}
+
+
+		// atomic integer base function implementations
+		// The __atomic builtins are generic over the integer width, so one
+		// definition serves the 8, 16, 32 and 64 bit types. Each of them compiles down
+		// to a single instruction, lock xadd, lock or or xchg on x86-64 and ldadd,
+		// ldset, ldclr, ldeor or swp on AArch64 with LSE.
+
+		template <class T>
+		inline T		atom_int_type<T>::get() const
+		{
+			return __atomic_load_n(&_data, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::set(T v)
+		{
+			__atomic_store_n(&_data, v, __ATOMIC_RELEASE);
+		}
+
+		// Memory order variants
+
+		template <class T>
+		inline T		atom_int_type<T>::load_relaxed() const
+		{
+			return __atomic_load_n(&_data, __ATOMIC_RELAXED);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::load_acquire() const
+		{
+			return __atomic_load_n(&_data, __ATOMIC_ACQUIRE);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::store_relaxed(T v)
+		{
+			__atomic_store_n(&_data, v, __ATOMIC_RELAXED);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::store_release(T v)
+		{
+			__atomic_store_n(&_data, v, __ATOMIC_RELEASE);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas(T old, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &old, n, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_relaxed(T old, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &old, n, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acquire(T old, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &old, n, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_release(T old, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &old, n, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acq_rel(T old, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &old, n, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::compare_exchange(T& expected, T n)
+		{
+			return __atomic_compare_exchange_n(&_data, &expected, n, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+		}
+
+
+		// Swap and return old value
+
+		template <class T>
+		inline T		atom_int_type<T>::swap(T i)
+		{
+			/// xchg with a memory operand is implicitly locked, swpal with LSE.
+			return __atomic_exchange_n(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+
+		// Increment
+
+		template <class T>
+		inline void		atom_int_type<T>::incr()
+		{
+			__atomic_add_fetch(&_data, (T)1, __ATOMIC_SEQ_CST);
+		}
+
+
+		// Test for zero and decrement if non-zero
+
+		template <class T>
+		inline bool		atom_int_type<T>::test_decr()
+		{
+			T old = __atomic_load_n(&_data, __ATOMIC_RELAXED);
+			do
+			{
+				if (old == 0)
+					return false;
+			} while (!__atomic_compare_exchange_n(&_data, &old, (T)(old - 1), false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+			return true;
+		}
+
+
+		// Decrement and test for non zero
+
+		template <class T>
+		inline bool		atom_int_type<T>::decr_test()
+		{
+			return __atomic_sub_fetch(&_data, (T)1, __ATOMIC_SEQ_CST) != 0;
+		}
+
+
+		// Decrement
+
+		template <class T>
+		inline void		atom_int_type<T>::decr()
+		{
+			__atomic_sub_fetch(&_data, (T)1, __ATOMIC_SEQ_CST);
+		}
+
+
+		// Add
+
+		template <class T>
+		inline void		atom_int_type<T>::add(T i)
+		{
+			__atomic_add_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+
+		// Subtract
+
+		template <class T>
+		inline void		atom_int_type<T>::sub(T i)
+		{
+			__atomic_sub_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_or(T i)
+		{
+			__atomic_or_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_xor(T i)
+		{
+			__atomic_xor_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_and(T i)
+		{
+			__atomic_and_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_set(u32 n)
+		{
+			T const i = ((T)1 << n);
+			__atomic_or_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_clr(u32 n)
+		{
+			T const i = ((T)1 << n);
+			__atomic_and_fetch(&_data, (T)~i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_chg(u32 n)
+		{
+			T const i = ((T)1 << n);
+			__atomic_xor_fetch(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		// The compiler recognizes 'fetch_op(1<<n) & (1<<n)' and emits lock bts/btr/btc
+		// on x86-64, with LSE these are a single ldsetal/ldclral/ldeoral on the mask.
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_set(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (__atomic_fetch_or(&_data, i, __ATOMIC_SEQ_CST) & i) != 0;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_clr(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (__atomic_fetch_and(&_data, (T)~i, __ATOMIC_SEQ_CST) & i) != 0;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_chg(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (__atomic_fetch_xor(&_data, i, __ATOMIC_SEQ_CST) & i) != 0;
+		}
+
+
+		// Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+
+		template <class T>
+		inline T		atom_int_type<T>::exchange(T i)
+		{
+			return __atomic_exchange_n(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_add(T i)
+		{
+			return __atomic_fetch_add(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_sub(T i)
+		{
+			return __atomic_fetch_sub(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_or(T i)
+		{
+			return __atomic_fetch_or(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_and(T i)
+		{
+			return __atomic_fetch_and(&_data, i, __ATOMIC_SEQ_CST);
+		}
+
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type()							{ set(0); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(const atom_int_type& i)	{ set(i.get()); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(T i)						{ set(i); }
+
+
+		// 8 bit signed integer
+
+		class atom_s8 : public atom_int_type<s8>
+		{
+		public:
+			atom_s8();
+			atom_s8(s8 i);
+		};
+
+		inline			atom_s8::atom_s8() : atom_int_type<s8>(0)				{ }
+		inline			atom_s8::atom_s8(s8 i) : atom_int_type<s8>(i)			{ }
+
+
+		// 8 bit unsigned integer
+
+		class atom_u8 : public atom_int_type<u8>
+		{
+		public:
+			atom_u8();
+			atom_u8(u8 i);
+		};
+
+		inline			atom_u8::atom_u8() : atom_int_type<u8>(0)				{ }
+		inline			atom_u8::atom_u8(u8 i) : atom_int_type<u8>(i)			{ }
+
+
+		// 16 bit signed integer
+
+		class atom_s16 : public atom_int_type<s16>
+		{
+		public:
+			atom_s16();
+			atom_s16(s16 i);
+		};
+
+		inline			atom_s16::atom_s16() : atom_int_type<s16>(0)				{ }
+		inline			atom_s16::atom_s16(s16 i) : atom_int_type<s16>(i)			{ }
+
+
+		// 16 bit unsigned integer
+
+		class atom_u16 : public atom_int_type<u16>
+		{
+		public:
+			atom_u16();
+			atom_u16(u16 i);
+		};
+
+		inline			atom_u16::atom_u16() : atom_int_type<u16>(0)				{ }
+		inline			atom_u16::atom_u16(u16 i) : atom_int_type<u16>(i)			{ }
+
+
+		// 32 bit signed integer
+
+		class atom_s32 : public atom_int_type<s32>
+		{
+		public:
+			atom_s32();
+			atom_s32(s32 i);
+		};
+
+		inline			atom_s32::atom_s32() : atom_int_type<s32>(0)				{ }
+		inline			atom_s32::atom_s32(s32 i) : atom_int_type<s32>(i)			{ }
+
+
+		// 32 bit unsigned integer
+
+		class atom_u32 : public atom_int_type<u32>
+		{
+		public:
+			atom_u32();
+			atom_u32(u32 i);
+		};
+
+		inline			atom_u32::atom_u32() : atom_int_type<u32>(0)				{ }
+		inline			atom_u32::atom_u32(u32 i) : atom_int_type<u32>(i)			{ }
+
+
+		// 64 bit signed integer
+
+		class atom_s64 : public atom_int_type<s64>
+		{
+		public:
+			atom_s64();
+			atom_s64(s64 i);
+		};
+
+		inline			atom_s64::atom_s64() : atom_int_type<s64>(0)				{ }
+		inline			atom_s64::atom_s64(s64 i) : atom_int_type<s64>(i)			{ }
+
+
+		// 64 bit unsigned integer
+
+		class atom_u64 : public atom_int_type<u64>
+		{
+		public:
+			atom_u64();
+			atom_u64(u64 i);
+		};
+
+		inline			atom_u64::atom_u64() : atom_int_type<u64>(0)				{ }
+		inline			atom_u64::atom_u64(u64 i) : atom_int_type<u64>(i)			{ }
+
+	}
+}
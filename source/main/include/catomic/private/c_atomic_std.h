@@ -0,0 +1,757 @@
+/**
+ * @file catomic\private\c_atomic_std.h
+ * Portable atomics on top of C++11 std::atomic, C++20 std::atomic_ref when available.
+ * Selected by defining D_ATOMIC_STD, works with any conforming compiler and cpu.
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+#include <atomic>
+
+namespace ncore
+{
+	namespace atomic
+	{
+		// All operations go through an atomic view of the plain integer, the
+		// volatile qualifier of the repo types is stripped for that.
+		namespace cpu_std
+		{
+			// std::atomic_ref is the sanctioned way to access a plain object atomically.
+			// Before C++20 the object is viewed as a std::atomic<U>, which has the same
+			// size and alignment as U on every implementation that is lock-free for U.
+#if defined(__cpp_lib_atomic_ref)
+			template <class U>
+			inline static std::atomic_ref<U> sAtomic(U const volatile *p)
+			{
+				return std::atomic_ref<U>(*const_cast<U*>(p));
+			}
+#else
+			template <class U>
+			inline static std::atomic<U>& sAtomic(U const volatile *p)
+			{
+				return *reinterpret_cast<std::atomic<U>*>(const_cast<U*>(p));
+			}
+#endif
+
+			inline static bool sInterlockedSetIfEqual(volatile u32 *dest, u32 exchange, u32 comperand)
+			{
+				return sAtomic(dest).compare_exchange_strong(comperand, exchange, std::memory_order_seq_cst);
+			}
+
+			inline static u32 sRead(volatile u32 *src)
+			{
+				return sAtomic(src).load(std::memory_order_seq_cst);
+			}
+
+			inline static void sWrite(volatile u32 *src, u32 v)
+			{
+				sAtomic(src).store(v, std::memory_order_release);
+			}
+
+			inline static bool sInterlockedSetIfEqual64(volatile u64 *dest, u64 exchange, u64 comperand)
+			{
+				return sAtomic(dest).compare_exchange_strong(comperand, exchange, std::memory_order_seq_cst);
+			}
+
+			inline static u64 sRead64(volatile u64 *src)
+			{
+				return sAtomic(src).load(std::memory_order_seq_cst);
+			}
+
+			inline static void sWrite64(volatile u64 *src, u64 v)
+			{
+				sAtomic(src).store(v, std::memory_order_release);
+			}
+
+			// 128 bit compare and exchange, on failure the current value is returned in cl:ch.
+			// Whether this is lock-free depends on the compiler and cpu, GCC on x86-64
+			// goes through libatomic (link with -latomic).
+			inline static bool sInterlockedCompareExchange128(volatile u64 *dest, u64 el, u64 eh, u64 &cl, u64 &ch)
+			{
+				u128 c; c.lo = cl; c.hi = ch;
+				u128 e; e.lo = el; e.hi = eh;
+				bool const r = sAtomic((volatile u128*)dest).compare_exchange_strong(c, e, std::memory_order_seq_cst);
+				cl = c.lo; ch = c.hi;
+				return r;
+			}
+
+			inline static void sRead128(volatile u64 *src, u64 &lo, u64 &hi)
+			{
+				u128 const v = sAtomic((volatile u128*)src).load(std::memory_order_seq_cst);
+				lo = v.lo; hi = v.hi;
+			}
+
+			// Explicitly ordered load, store and compare and swap. A failed compare and
+			// swap can not be a release.
+
+			template <class U, std::memory_order O>
+			inline static U sReadOrdered(volatile U *src)
+			{
+				return sAtomic(src).load(O);
+			}
+
+			template <class U, std::memory_order O>
+			inline static void sWriteOrdered(volatile U *src, U v)
+			{
+				sAtomic(src).store(v, O);
+			}
+
+			template <class U, std::memory_order O, std::memory_order F>
+			inline static bool sSetIfEqualOrdered(volatile U *dest, U exchange, U comperand)
+			{
+				return sAtomic(dest).compare_exchange_strong(comperand, exchange, O, F);
+			}
+		}
+
+		namespace cpu_interlocked = cpu_std;
+
+
+		// 32 bit signed integer
+
+		static inline s32	read_s32(s32 volatile* p)
+		{
+			return (s32)cpu_interlocked::sRead((u32 volatile*)p);
+		}
+
+		static inline void	write_s32(s32 volatile* p, s32 v)
+		{
+			cpu_interlocked::sWrite((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_s32(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_interlocked::sInterlockedSetIfEqual((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32(volatile s32* mem, s16 ol, s16 oh, s16 nl, s16 nh)
+		{
+			u32 old = (u16)oh; old = old << 16; old = old | (u16)ol;
+			u32 n = (u16)nh; n = n << 16; n = n | (u16)nl;
+			return cpu_interlocked::sInterlockedSetIfEqual((u32 volatile*)mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline s32	read_s32_relaxed(s32 volatile* p)
+		{
+			return (s32)cpu_interlocked::sReadOrdered<u32, std::memory_order_relaxed>((u32 volatile*)p);
+		}
+
+		static inline s32	read_s32_acquire(s32 volatile* p)
+		{
+			return (s32)cpu_interlocked::sReadOrdered<u32, std::memory_order_acquire>((u32 volatile*)p);
+		}
+
+		static inline void	write_s32_relaxed(s32 volatile* p, s32 v)
+		{
+			cpu_interlocked::sWriteOrdered<u32, std::memory_order_relaxed>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_s32_release(s32 volatile* p, s32 v)
+		{
+			cpu_interlocked::sWriteOrdered<u32, std::memory_order_release>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_s32_relaxed(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_relaxed, std::memory_order_relaxed>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_acquire(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_acquire, std::memory_order_acquire>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_release(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_release, std::memory_order_relaxed>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_s32_acq_rel(s32 volatile* mem, s32 old, s32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_acq_rel, std::memory_order_acquire>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+
+		// 32 bit unsigned integer
+
+		static inline u32	read_u32(u32 volatile* p)
+		{
+			return cpu_interlocked::sRead(p);
+		}
+
+		static inline void	write_u32(u32 volatile* p, u32 v)
+		{
+			cpu_interlocked::sWrite(p, v);
+		}
+
+		static inline bool	cas_u32(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_interlocked::sInterlockedSetIfEqual(mem, n, old);
+		}
+
+		static inline bool	cas_u32(volatile u32* mem, u16 ol, u16 oh, u16 nl, u16 nh)
+		{
+			u32 old = oh; old = old << 16; old = old | ol;
+			u32 n = nh; n = n << 16; n = n | nl;
+			return cpu_interlocked::sInterlockedSetIfEqual(mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline u32	read_u32_relaxed(u32 volatile* p)
+		{
+			return (u32)cpu_interlocked::sReadOrdered<u32, std::memory_order_relaxed>((u32 volatile*)p);
+		}
+
+		static inline u32	read_u32_acquire(u32 volatile* p)
+		{
+			return (u32)cpu_interlocked::sReadOrdered<u32, std::memory_order_acquire>((u32 volatile*)p);
+		}
+
+		static inline void	write_u32_relaxed(u32 volatile* p, u32 v)
+		{
+			cpu_interlocked::sWriteOrdered<u32, std::memory_order_relaxed>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_u32_release(u32 volatile* p, u32 v)
+		{
+			cpu_interlocked::sWriteOrdered<u32, std::memory_order_release>((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_u32_relaxed(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_relaxed, std::memory_order_relaxed>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_acquire(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_acquire, std::memory_order_acquire>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_release(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_release, std::memory_order_relaxed>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+		static inline bool	cas_u32_acq_rel(u32 volatile* mem, u32 old, u32 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u32, std::memory_order_acq_rel, std::memory_order_acquire>((u32 volatile*)mem, (u32)n, (u32)old);
+		}
+
+
+		// 64 bit signed integer
+
+		static inline s64	read_s64(s64 volatile* p)
+		{
+			return (s64)cpu_interlocked::sRead64((volatile u64*)p);
+		}
+
+		static inline void	write_s64(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWrite64((volatile u64*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_interlocked::sInterlockedSetIfEqual64((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64(volatile s64* mem, s32 ol, s32 oh, s32 nl, s32 nh)
+		{
+			u64 old = (u32)oh; old = old << 32; old = old | (u32)ol;
+			u64 n = (u32)nh; n = n << 32; n = n | (u32)nl;
+			return cpu_interlocked::sInterlockedSetIfEqual64((u64 volatile*)mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline s64	read_s64_relaxed(s64 volatile* p)
+		{
+			return (s64)cpu_interlocked::sReadOrdered<u64, std::memory_order_relaxed>((u64 volatile*)p);
+		}
+
+		static inline s64	read_s64_acquire(s64 volatile* p)
+		{
+			return (s64)cpu_interlocked::sReadOrdered<u64, std::memory_order_acquire>((u64 volatile*)p);
+		}
+
+		static inline void	write_s64_relaxed(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWriteOrdered<u64, std::memory_order_relaxed>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_s64_release(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWriteOrdered<u64, std::memory_order_release>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64_relaxed(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_relaxed, std::memory_order_relaxed>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_acquire(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_acquire, std::memory_order_acquire>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_release(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_release, std::memory_order_relaxed>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_s64_acq_rel(s64 volatile* mem, s64 old, s64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_acq_rel, std::memory_order_acquire>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+
+		// 64 bit unsigned integer
+
+		static inline u64	read_u64(volatile u64* p)
+		{
+			return cpu_interlocked::sRead64(p);
+		}
+
+		static inline void	write_u64(volatile u64* p, u64 v)
+		{
+			cpu_interlocked::sWrite64(p, v);
+		}
+
+		static inline bool	cas_u64(volatile u64* mem, u64 old, u64 n)
+		{
+			return cpu_interlocked::sInterlockedSetIfEqual64(mem, n, old);
+		}
+
+		static inline bool	cas_u64(volatile u64* mem, u32 ol, u32 oh, u32 nl, u32 nh)
+		{
+			u64 old = oh; old = old << 32; old = old | ol;
+			u64 n = nh; n = n << 32; n = n | nl;
+			return cpu_interlocked::sInterlockedSetIfEqual64(mem, n, old);
+		}
+
+		// Memory order variants
+
+		static inline u64	read_u64_relaxed(u64 volatile* p)
+		{
+			return (u64)cpu_interlocked::sReadOrdered<u64, std::memory_order_relaxed>((u64 volatile*)p);
+		}
+
+		static inline u64	read_u64_acquire(u64 volatile* p)
+		{
+			return (u64)cpu_interlocked::sReadOrdered<u64, std::memory_order_acquire>((u64 volatile*)p);
+		}
+
+		static inline void	write_u64_relaxed(u64 volatile* p, u64 v)
+		{
+			cpu_interlocked::sWriteOrdered<u64, std::memory_order_relaxed>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_u64_release(u64 volatile* p, u64 v)
+		{
+			cpu_interlocked::sWriteOrdered<u64, std::memory_order_release>((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_u64_relaxed(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_relaxed, std::memory_order_relaxed>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_acquire(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_acquire, std::memory_order_acquire>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_release(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_release, std::memory_order_relaxed>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+		static inline bool	cas_u64_acq_rel(u64 volatile* mem, u64 old, u64 n)
+		{
+			return cpu_interlocked::sSetIfEqualOrdered<u64, std::memory_order_acq_rel, std::memory_order_acquire>((u64 volatile*)mem, (u64)n, (u64)old);
+		}
+
+
+		// 128 bit unsigned integer
+
+		static inline u128	read_u128(u128 volatile* p)
+		{
+			u128 r;
+			cpu_interlocked::sRead128((u64 volatile*)p, r.lo, r.hi);
+			return r;
+		}
+
+		static inline void	write_u128(u128 volatile* p, u128 v)
+		{
+			cpu_interlocked::sAtomic(p).store(v, std::memory_order_release);
+		}
+
+		static inline bool	cas_u128(u128 volatile* mem, u128 old, u128 n)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, n.lo, n.hi, old.lo, old.hi);
+		}
+
+		static inline bool	cas_u128(u128 volatile* mem, u64 ol, u64 oh, u64 nl, u64 nh)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, nl, nh, ol, oh);
+		}
+
+		static inline bool	compare_exchange_u128(u128 volatile* mem, u128& expected, u128 n)
+		{
+			return cpu_interlocked::sInterlockedCompareExchange128((u64 volatile*)mem, n.lo, n.hi, expected.lo, expected.hi);
+		}
+
+
+		// atomic integer base function implementations
+		// One generic definition serves the 8, 16, 32 and 64 bit types, the compiler picks
+		// the instruction that matches the target.
+
+		template <class T>
+		inline T		atom_int_type<T>::get() const
+		{
+			return cpu_interlocked::sAtomic(&_data).load(std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::set(T v)
+		{
+			cpu_interlocked::sAtomic(&_data).store(v, std::memory_order_release);
+		}
+
+		// Memory order variants
+
+		template <class T>
+		inline T		atom_int_type<T>::load_relaxed() const
+		{
+			return cpu_interlocked::sAtomic(&_data).load(std::memory_order_relaxed);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::load_acquire() const
+		{
+			return cpu_interlocked::sAtomic(&_data).load(std::memory_order_acquire);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::store_relaxed(T v)
+		{
+			cpu_interlocked::sAtomic(&_data).store(v, std::memory_order_relaxed);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::store_release(T v)
+		{
+			cpu_interlocked::sAtomic(&_data).store(v, std::memory_order_release);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas(T old, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, n, std::memory_order_seq_cst, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_relaxed(T old, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, n, std::memory_order_relaxed, std::memory_order_relaxed);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acquire(T old, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, n, std::memory_order_acquire, std::memory_order_acquire);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_release(T old, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, n, std::memory_order_release, std::memory_order_relaxed);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acq_rel(T old, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, n, std::memory_order_acq_rel, std::memory_order_acquire);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::compare_exchange(T& expected, T n)
+		{
+			return cpu_interlocked::sAtomic(&_data).compare_exchange_strong(expected, n, std::memory_order_seq_cst, std::memory_order_seq_cst);
+		}
+
+
+		// Swap and return old value
+
+		template <class T>
+		inline T		atom_int_type<T>::swap(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).exchange(i, std::memory_order_seq_cst);
+		}
+
+
+		// Increment
+
+		template <class T>
+		inline void		atom_int_type<T>::incr()
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_add((T)1, std::memory_order_seq_cst);
+		}
+
+
+		// Test for zero and decrement if non-zero
+
+		template <class T>
+		inline bool		atom_int_type<T>::test_decr()
+		{
+			T old = cpu_interlocked::sAtomic(&_data).load(std::memory_order_relaxed);
+			do
+			{
+				if (old == 0)
+					return false;
+			} while (!cpu_interlocked::sAtomic(&_data).compare_exchange_strong(old, (T)(old - 1), std::memory_order_seq_cst, std::memory_order_relaxed));
+			return true;
+		}
+
+
+		// Decrement and test for non zero
+
+		template <class T>
+		inline bool		atom_int_type<T>::decr_test()
+		{
+			return cpu_interlocked::sAtomic(&_data).fetch_sub((T)1, std::memory_order_seq_cst) != (T)1;
+		}
+
+
+		// Decrement
+
+		template <class T>
+		inline void		atom_int_type<T>::decr()
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_sub((T)1, std::memory_order_seq_cst);
+		}
+
+
+		// Add
+
+		template <class T>
+		inline void		atom_int_type<T>::add(T i)
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_add(i, std::memory_order_seq_cst);
+		}
+
+
+		// Subtract
+
+		template <class T>
+		inline void		atom_int_type<T>::sub(T i)
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_sub(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_or(T i)
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_or(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_xor(T i)
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_xor(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_and(T i)
+		{
+			cpu_interlocked::sAtomic(&_data).fetch_and(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_set(u32 n)
+		{
+			T const i = ((T)1 << n);
+			cpu_interlocked::sAtomic(&_data).fetch_or(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_clr(u32 n)
+		{
+			T const i = ((T)1 << n);
+			cpu_interlocked::sAtomic(&_data).fetch_and((T)~i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_chg(u32 n)
+		{
+			T const i = ((T)1 << n);
+			cpu_interlocked::sAtomic(&_data).fetch_xor(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_set(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (cpu_interlocked::sAtomic(&_data).fetch_or(i, std::memory_order_seq_cst) & i) != 0;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_clr(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (cpu_interlocked::sAtomic(&_data).fetch_and((T)~i, std::memory_order_seq_cst) & i) != 0;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_chg(u32 n)
+		{
+			T const i = ((T)1 << n);
+			return (cpu_interlocked::sAtomic(&_data).fetch_xor(i, std::memory_order_seq_cst) & i) != 0;
+		}
+
+
+		// Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+
+		template <class T>
+		inline T		atom_int_type<T>::exchange(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).exchange(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_add(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).fetch_add(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_sub(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).fetch_sub(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_or(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).fetch_or(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::fetch_and(T i)
+		{
+			return cpu_interlocked::sAtomic(&_data).fetch_and(i, std::memory_order_seq_cst);
+		}
+
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type()							{ set(0); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(const atom_int_type& i)	{ set(i.get()); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(T i)						{ set(i); }
+
+
+		// 8 bit signed integer
+
+		class atom_s8 : public atom_int_type<s8>
+		{
+		public:
+			atom_s8();
+			atom_s8(s8 i);
+		};
+
+		inline			atom_s8::atom_s8() : atom_int_type<s8>(0)				{ }
+		inline			atom_s8::atom_s8(s8 i) : atom_int_type<s8>(i)			{ }
+
+
+		// 8 bit unsigned integer
+
+		class atom_u8 : public atom_int_type<u8>
+		{
+		public:
+			atom_u8();
+			atom_u8(u8 i);
+		};
+
+		inline			atom_u8::atom_u8() : atom_int_type<u8>(0)				{ }
+		inline			atom_u8::atom_u8(u8 i) : atom_int_type<u8>(i)			{ }
+
+
+		// 16 bit signed integer
+
+		class atom_s16 : public atom_int_type<s16>
+		{
+		public:
+			atom_s16();
+			atom_s16(s16 i);
+		};
+
+		inline			atom_s16::atom_s16() : atom_int_type<s16>(0)				{ }
+		inline			atom_s16::atom_s16(s16 i) : atom_int_type<s16>(i)			{ }
+
+
+		// 16 bit unsigned integer
+
+		class atom_u16 : public atom_int_type<u16>
+		{
+		public:
+			atom_u16();
+			atom_u16(u16 i);
+		};
+
+		inline			atom_u16::atom_u16() : atom_int_type<u16>(0)				{ }
+		inline			atom_u16::atom_u16(u16 i) : atom_int_type<u16>(i)			{ }
+
+
+		// 32 bit signed integer
+
+		class atom_s32 : public atom_int_type<s32>
+		{
+		public:
+			atom_s32();
+			atom_s32(s32 i);
+		};
+
+		inline			atom_s32::atom_s32() : atom_int_type<s32>(0)				{ }
+		inline			atom_s32::atom_s32(s32 i) : atom_int_type<s32>(i)			{ }
+
+
+		// 32 bit unsigned integer
+
+		class atom_u32 : public atom_int_type<u32>
+		{
+		public:
+			atom_u32();
+			atom_u32(u32 i);
+		};
+
+		inline			atom_u32::atom_u32() : atom_int_type<u32>(0)				{ }
+		inline			atom_u32::atom_u32(u32 i) : atom_int_type<u32>(i)			{ }
+
+
+		// 64 bit signed integer
+
+		class atom_s64 : public atom_int_type<s64>
+		{
+		public:
+			atom_s64();
+			atom_s64(s64 i);
+		};
+
+		inline			atom_s64::atom_s64() : atom_int_type<s64>(0)				{ }
+		inline			atom_s64::atom_s64(s64 i) : atom_int_type<s64>(i)			{ }
+
+
+		// 64 bit unsigned integer
+
+		class atom_u64 : public atom_int_type<u64>
+		{
+		public:
+			atom_u64();
+			atom_u64(u64 i);
+		};
+
+		inline			atom_u64::atom_u64() : atom_int_type<u64>(0)				{ }
+		inline			atom_u64::atom_u64(u64 i) : atom_int_type<u64>(i)			{ }
+
+	}
+}
@@ -0,0 +1,39 @@
+/**
+ * @file catomic\private\c_atomic_x86_linux64.h
+ * X86-64 atomics for GCC and Clang on Linux.
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+
+namespace ncore
+{
+	namespace atomic
+	{
+		// The cpu specific part, everything else is in c_atomic_gcc.h
+		namespace cpu_x86_64
+		{
+			// 128 bit compare and exchange, cmpxchg16b is used directly so that we do not
+			// depend on -mcx16 or libatomic. On failure the current value is returned in cl:ch.
+			inline static bool sInterlockedCompareExchange128(volatile u64 *dest, u64 el, u64 eh, u64 &cl, u64 &ch)
+			{
+				bool r;
+				__asm__ __volatile__("lock; cmpxchg16b %1\n\tsete %0"
+					: "=q"(r), "+m"(*(volatile u128*)dest), "+a"(cl), "+d"(ch)
+					: "b"(el), "c"(eh)
+					: "memory", "cc");
+				return r;
+			}
+
+			// Comparing with zero and writing back zero leaves memory unchanged
+			// and returns the current value.
+			inline static void sRead128(volatile u64 *src, u64 &lo, u64 &hi)
+			{
+				lo = 0; hi = 0;
+				sInterlockedCompareExchange128(src, 0, 0, lo, hi);
+			}
+		}
+
+		namespace cpu_interlocked = cpu_x86_64;
+	}
+}
+
+#include "catomic/private/c_atomic_gcc.h"
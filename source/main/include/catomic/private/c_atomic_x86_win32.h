@@ -4,6 +4,7 @@
 #define NOMB
 #define NOKANJI
 #include <windows.h>
+#include <intrin.h>
 
 namespace ncore
 {
@@ -114,7 +115,63 @@ namespace ncore
 				*src = v;
 			}
 
+			/**
+			 * Plain loads and stores. X86 does not reorder loads with loads or stores with
+			 * stores, acquire and release only have to keep the compiler from reordering.
+			 * A 64 bit load is not atomic on a 32 bit cpu, those stay on cmpxchg8b.
+			 */
+			inline static u32 sReadRelaxed(volatile u32 *src)					{ return *src; }
+			inline static u32 sReadAcquire(volatile u32 *src)					{ u32 v = *src; _ReadWriteBarrier(); return v; }
+			inline static void sWriteRelaxed(volatile u32 *src, u32 v)			{ *src = v; }
+			inline static void sWriteRelease(volatile u32 *src, u32 v)			{ _ReadWriteBarrier(); *src = v; }
+
+			inline static u64 sReadRelaxed64(volatile u64 *src)				{ return sRead64(src); }
+			inline static u64 sReadAcquire64(volatile u64 *src)				{ return sRead64(src); }
+			inline static void sWriteRelaxed64(volatile u64 *src, u64 v)		{ sWrite64(src, v); }
+			inline static void sWriteRelease64(volatile u64 *src, u64 v)		{ _ReadWriteBarrier(); sWrite64(src, v); }
+
 			#pragma warning(default:4035)
+
+			/**
+			 * Single instruction read-modify-write operations on 32 bit values (xchg,
+			 * lock xadd, lock or, lock bts, ...), they return the value held before
+			 * the operation. There are no 64 bit versions on a 32 bit cpu, those stay
+			 * on cmpxchg8b loops.
+			 */
+			inline static u32 sExchange(volatile u32 *dest, u32 v)
+			{
+				return (u32)::_InterlockedExchange((volatile long*)dest, (long)v);
+			}
+
+			inline static u32 sExchangeAdd(volatile u32 *dest, u32 v)
+			{
+				return (u32)::_InterlockedExchangeAdd((volatile long*)dest, (long)v);
+			}
+
+			inline static u32 sOr(volatile u32 *dest, u32 v)
+			{
+				return (u32)::_InterlockedOr((volatile long*)dest, (long)v);
+			}
+
+			inline static u32 sAnd(volatile u32 *dest, u32 v)
+			{
+				return (u32)::_InterlockedAnd((volatile long*)dest, (long)v);
+			}
+
+			inline static u32 sXor(volatile u32 *dest, u32 v)
+			{
+				return (u32)::_InterlockedXor((volatile long*)dest, (long)v);
+			}
+
+			inline static bool sBitTestSet(volatile u32 *dest, u32 n)
+			{
+				return ::_interlockedbittestandset((volatile long*)dest, (long)n) != 0;
+			}
+
+			inline static bool sBitTestReset(volatile u32 *dest, u32 n)
+			{
+				return ::_interlockedbittestandreset((volatile long*)dest, (long)n) != 0;
+			}
 		}
 
 		namespace cpu_interlocked = cpu_x86_32;
@@ -153,6 +210,34 @@ namespace ncore
 			return r == old;
 		}
 
+		// Memory order variants. Every locked instruction is a full barrier on x86, so the
+		// cas variants all map onto the same lock cmpxchg, only loads and stores differ.
+
+		static inline s32	read_s32_relaxed(s32 volatile* p)
+		{
+			return (s32)cpu_interlocked::sReadRelaxed((u32 volatile*)p);
+		}
+
+		static inline s32	read_s32_acquire(s32 volatile* p)
+		{
+			return (s32)cpu_interlocked::sReadAcquire((u32 volatile*)p);
+		}
+
+		static inline void	write_s32_relaxed(s32 volatile* p, s32 v)
+		{
+			cpu_interlocked::sWriteRelaxed((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_s32_release(s32 volatile* p, s32 v)
+		{
+			cpu_interlocked::sWriteRelease((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_s32_relaxed(s32 volatile* mem, s32 old, s32 n)	{ return cas_s32(mem, old, n); }
+		static inline bool	cas_s32_acquire(s32 volatile* mem, s32 old, s32 n)	{ return cas_s32(mem, old, n); }
+		static inline bool	cas_s32_release(s32 volatile* mem, s32 old, s32 n)	{ return cas_s32(mem, old, n); }
+		static inline bool	cas_s32_acq_rel(s32 volatile* mem, s32 old, s32 n)	{ return cas_s32(mem, old, n); }
+
 		/**
 		 * atomic integer base function implementations
 		 */
@@ -168,6 +253,73 @@ namespace ncore
 			write_s32(&_data, v); 
 		}
 
+		/**
+		 * Memory order variants
+		 */
+		template <>
+		inline s32		atom_int_type<s32>::load_relaxed() const
+		{
+			return read_s32_relaxed((s32 volatile*)&_data);
+		}
+
+		template <>
+		inline s32		atom_int_type<s32>::load_acquire() const
+		{
+			return read_s32_acquire((s32 volatile*)&_data);
+		}
+
+		template <>
+		inline void		atom_int_type<s32>::store_relaxed(s32 v)
+		{
+			write_s32_relaxed(&_data, v);
+		}
+
+		template <>
+		inline void		atom_int_type<s32>::store_release(s32 v)
+		{
+			write_s32_release(&_data, v);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::cas(s32 old, s32 n)
+		{
+			return cas_s32(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::cas_relaxed(s32 old, s32 n)
+		{
+			return cas_s32_relaxed(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::cas_acquire(s32 old, s32 n)
+		{
+			return cas_s32_acquire(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::cas_release(s32 old, s32 n)
+		{
+			return cas_s32_release(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::cas_acq_rel(s32 old, s32 n)
+		{
+			return cas_s32_acq_rel(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<s32>::compare_exchange(s32& expected, s32 n)
+		{
+			s32 const old = (s32)cpu_interlocked::sInterlockedCompareExchange((u32 volatile*)&_data, (u32)n, (u32)expected);
+			if (old == expected)
+				return true;
+			expected = old;
+			return false;
+		}
+
 		/**
 		 * Swap and return old value
 		 */
@@ -175,12 +327,7 @@ namespace ncore
 		inline s32		atom_int_type<s32>::swap(s32 i)
 		{
 			/// Automatically locks when doing this op with a memory operand.
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, i) == false);
-			return old;
+			return (s32)cpu_interlocked::sExchange((u32 volatile*)&_data, (u32)i);
 		}
 
 		/**
@@ -189,11 +336,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s32>::incr()
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old + 1) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, 1);
 		}
 
 		/**
@@ -202,7 +345,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<s32>::test_decr()
 		{
-			register s32 old;
+			s32 old;
 			do
 			{
 				old = read_s32((s32 volatile*)&_data);
@@ -218,11 +361,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<s32>::decr_test()
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old - 1) == false);
+			s32 const old = (s32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)-1);
 			return (old-1) != 0;
 		}
 
@@ -232,11 +371,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s32>::decr()
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old - 1) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)-1);
 		}
 
 		/**
@@ -245,11 +380,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s32>::add(s32 i)
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old + i) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)i);
 		}
 
 		/**
@@ -258,112 +389,99 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s32>::sub(s32 i)
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old - i) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)0 - (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_or(s32 i)
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old | i) == false);
+			cpu_interlocked::sOr((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_xor(s32 i)
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old ^ i) == false);
+			cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_and(s32 i)
 		{
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old & i) == false);
+			cpu_interlocked::sAnd((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_set(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old | i) == false);
+			cpu_interlocked::sBitTestSet((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_clr(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old & ~i) == false);
+			cpu_interlocked::sBitTestReset((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline void		atom_int_type<s32>::bit_chg(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old ^ i) == false);
+			s32 const i = ((s32)1<<n);
+			cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline bool		atom_int_type<s32>::bit_test_set(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old | i) == false);
-			return (old & i) != 0;
+			return cpu_interlocked::sBitTestSet((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline bool		atom_int_type<s32>::bit_test_clr(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old & ~i) == false);
-			return (old & i) != 0;
+			return cpu_interlocked::sBitTestReset((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline bool		atom_int_type<s32>::bit_test_chg(u32 n)
 		{
-			s32 const i = (1<<n);
-			register s32 old;
-			do
-			{
-				old = read_s32((s32 volatile*)&_data);
-			} while (cas_s32(&_data, old, old ^ i) == false);
+			s32 const i = ((s32)1<<n);
+			s32 const old = (s32)cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 			return (old & i) != 0;
 		}
 
+		/**
+		 * Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+		 */
+		template <>
+		inline s32		atom_int_type<s32>::exchange(s32 i)
+		{
+			return (s32)cpu_interlocked::sExchange((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline s32		atom_int_type<s32>::fetch_add(s32 i)
+		{
+			return (s32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline s32		atom_int_type<s32>::fetch_sub(s32 i)
+		{
+			return (s32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)0 - (u32)i);
+		}
+
+		template <>
+		inline s32		atom_int_type<s32>::fetch_or(s32 i)
+		{
+			return (s32)cpu_interlocked::sOr((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline s32		atom_int_type<s32>::fetch_and(s32 i)
+		{
+			return (s32)cpu_interlocked::sAnd((u32 volatile*)&_data, (u32)i);
+		}
+
 		template <>
 		inline			atom_int_type<s32>::atom_int_type()							{ set(0); }
 		template <>
@@ -408,6 +526,34 @@ namespace ncore
 			return r == old;
 		}
 
+		// Memory order variants. Every locked instruction is a full barrier on x86, so the
+		// cas variants all map onto the same lock cmpxchg, only loads and stores differ.
+
+		static inline u32	read_u32_relaxed(u32 volatile* p)
+		{
+			return (u32)cpu_interlocked::sReadRelaxed((u32 volatile*)p);
+		}
+
+		static inline u32	read_u32_acquire(u32 volatile* p)
+		{
+			return (u32)cpu_interlocked::sReadAcquire((u32 volatile*)p);
+		}
+
+		static inline void	write_u32_relaxed(u32 volatile* p, u32 v)
+		{
+			cpu_interlocked::sWriteRelaxed((u32 volatile*)p, (u32)v);
+		}
+
+		static inline void	write_u32_release(u32 volatile* p, u32 v)
+		{
+			cpu_interlocked::sWriteRelease((u32 volatile*)p, (u32)v);
+		}
+
+		static inline bool	cas_u32_relaxed(u32 volatile* mem, u32 old, u32 n)	{ return cas_u32(mem, old, n); }
+		static inline bool	cas_u32_acquire(u32 volatile* mem, u32 old, u32 n)	{ return cas_u32(mem, old, n); }
+		static inline bool	cas_u32_release(u32 volatile* mem, u32 old, u32 n)	{ return cas_u32(mem, old, n); }
+		static inline bool	cas_u32_acq_rel(u32 volatile* mem, u32 old, u32 n)	{ return cas_u32(mem, old, n); }
+
 		/**
 		 * atomic integer base function implementations
 		 */
@@ -423,6 +569,73 @@ namespace ncore
 			write_u32(&_data, v); 
 		}
 
+		/**
+		 * Memory order variants
+		 */
+		template <>
+		inline u32		atom_int_type<u32>::load_relaxed() const
+		{
+			return read_u32_relaxed((u32 volatile*)&_data);
+		}
+
+		template <>
+		inline u32		atom_int_type<u32>::load_acquire() const
+		{
+			return read_u32_acquire((u32 volatile*)&_data);
+		}
+
+		template <>
+		inline void		atom_int_type<u32>::store_relaxed(u32 v)
+		{
+			write_u32_relaxed(&_data, v);
+		}
+
+		template <>
+		inline void		atom_int_type<u32>::store_release(u32 v)
+		{
+			write_u32_release(&_data, v);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::cas(u32 old, u32 n)
+		{
+			return cas_u32(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::cas_relaxed(u32 old, u32 n)
+		{
+			return cas_u32_relaxed(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::cas_acquire(u32 old, u32 n)
+		{
+			return cas_u32_acquire(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::cas_release(u32 old, u32 n)
+		{
+			return cas_u32_release(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::cas_acq_rel(u32 old, u32 n)
+		{
+			return cas_u32_acq_rel(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::compare_exchange(u32& expected, u32 n)
+		{
+			u32 const old = (u32)cpu_interlocked::sInterlockedCompareExchange((u32 volatile*)&_data, (u32)n, (u32)expected);
+			if (old == expected)
+				return true;
+			expected = old;
+			return false;
+		}
+
 		/**
 		 * Swap and return old value
 		 */
@@ -430,12 +643,7 @@ namespace ncore
 		inline u32		atom_int_type<u32>::swap(u32 i)
 		{
 			/// Automatically locks when doing this op with a memory operand.
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, i) == false);
-			return old;
+			return (u32)cpu_interlocked::sExchange((u32 volatile*)&_data, (u32)i);
 		}
 
 		/**
@@ -444,11 +652,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u32>::incr()
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old + 1) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, 1);
 		}
 
 		/**
@@ -457,7 +661,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<u32>::test_decr()
 		{
-			register u32 old;
+			u32 old;
 			do
 			{
 				old = read_u32((u32 volatile*)&_data);
@@ -473,11 +677,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<u32>::decr_test()
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old - 1) == false);
+			u32 const old = (u32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)-1);
 			return (old-1) != 0;
 		}
 
@@ -487,11 +687,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u32>::decr()
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old - 1) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)-1);
 		}
 
 		/**
@@ -500,11 +696,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u32>::add(u32 i)
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old + i) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)i);
 		}
 
 		/**
@@ -513,170 +705,252 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u32>::sub(u32 i)
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old - i) == false);
+			cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)0 - (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_or(u32 i)
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old | i) == false);
+			cpu_interlocked::sOr((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_xor(u32 i)
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old ^ i) == false);
+			cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_and(u32 i)
 		{
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old & i) == false);
+			cpu_interlocked::sAnd((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_set(u32 n)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old | i) == false);
+			cpu_interlocked::sBitTestSet((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_clr(u32 n)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old & ~i) == false);
+			cpu_interlocked::sBitTestReset((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline void		atom_int_type<u32>::bit_chg(u32 n)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old ^ i) == false);
+			u32 const i = ((u32)1<<n);
+			cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 		}
 
 		template <>
 		inline bool		atom_int_type<u32>::bit_test_set(u32 n)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old | i) == false);
-			return (old & i) != 0;
+			return cpu_interlocked::sBitTestSet((u32 volatile*)&_data, n);
 		}
 
 		template <>
 		inline bool		atom_int_type<u32>::bit_test_clr(u32 n)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old & ~i) == false);
+			return cpu_interlocked::sBitTestReset((u32 volatile*)&_data, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u32>::bit_test_chg(u32 n)
+		{
+			u32 const i = ((u32)1<<n);
+			u32 const old = (u32)cpu_interlocked::sXor((u32 volatile*)&_data, (u32)i);
 			return (old & i) != 0;
 		}
 
+		/**
+		 * Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+		 */
+		template <>
+		inline u32		atom_int_type<u32>::exchange(u32 i)
+		{
+			return (u32)cpu_interlocked::sExchange((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline u32		atom_int_type<u32>::fetch_add(u32 i)
+		{
+			return (u32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline u32		atom_int_type<u32>::fetch_sub(u32 i)
+		{
+			return (u32)cpu_interlocked::sExchangeAdd((u32 volatile*)&_data, (u32)0 - (u32)i);
+		}
+
+		template <>
+		inline u32		atom_int_type<u32>::fetch_or(u32 i)
+		{
+			return (u32)cpu_interlocked::sOr((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline u32		atom_int_type<u32>::fetch_and(u32 i)
+		{
+			return (u32)cpu_interlocked::sAnd((u32 volatile*)&_data, (u32)i);
+		}
+
+		template <>
+		inline			atom_int_type<u32>::atom_int_type()							{ set(0); }
+		template <>
+		inline			atom_int_type<u32>::atom_int_type(const atom_int_type& i)	{ set(i.get()); }
+		template <>
+		inline			atom_int_type<u32>::atom_int_type(u32 i)					{ set(i); }
+
+		inline			atom_u32::atom_u32() : atom_int_type<u32>(0)				{ }
+		inline			atom_u32::atom_u32(u32 i) : atom_int_type<u32>(i)			{ }
+
+		/**
+		 * 64 bit signed integer
+		 */
+		class atom_s64 : public atom_int_type<s64>
+		{
+		public:
+			atom_s64();
+			atom_s64(s64 i);
+		};
+
+		static inline s64	read_s64(s64 volatile* p)
+		{
+			return cpu_interlocked::sRead64((volatile u64*)p);
+		}
+
+		static inline void	write_s64(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWrite64((volatile u64*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64(s64 volatile* mem, s64 old, s64 n)
+		{
+			s64 r = (s64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)mem, (u64)n, (u64)old);
+			return r == old;
+		}
+
+		static inline bool	cas_s64(volatile s64* mem, s32 ol, s32 oh, s32 nl, s32 nh)
+		{
+			u64 old = oh; old = old << 32; old = old | ol;
+			u64 n = nh; n = n << 32; n = n | nl;
+			s64 r = (s64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)mem, (u64)n, (u64)old);
+			return r == old;
+		}
+
+		// Memory order variants. Every locked instruction is a full barrier on x86, so the
+		// cas variants all map onto the same lock cmpxchg, only loads and stores differ.
+
+		static inline s64	read_s64_relaxed(s64 volatile* p)
+		{
+			return (s64)cpu_interlocked::sReadRelaxed64((u64 volatile*)p);
+		}
+
+		static inline s64	read_s64_acquire(s64 volatile* p)
+		{
+			return (s64)cpu_interlocked::sReadAcquire64((u64 volatile*)p);
+		}
+
+		static inline void	write_s64_relaxed(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWriteRelaxed64((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_s64_release(s64 volatile* p, s64 v)
+		{
+			cpu_interlocked::sWriteRelease64((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_s64_relaxed(s64 volatile* mem, s64 old, s64 n)	{ return cas_s64(mem, old, n); }
+		static inline bool	cas_s64_acquire(s64 volatile* mem, s64 old, s64 n)	{ return cas_s64(mem, old, n); }
+		static inline bool	cas_s64_release(s64 volatile* mem, s64 old, s64 n)	{ return cas_s64(mem, old, n); }
+		static inline bool	cas_s64_acq_rel(s64 volatile* mem, s64 old, s64 n)	{ return cas_s64(mem, old, n); }
+
+		/**
+		 * atomic integer base function implementations
+		 */
+
+		template <>
+		inline s64		atom_int_type<s64>::get() const
+		{
+			return read_s64((s64 volatile*)&_data); 
+		}
+
+		template <>
+		inline void		atom_int_type<s64>::set(s64 v)
+		{
+			write_s64(&_data, v); 
+		}
+
+		/**
+		 * Memory order variants
+		 */
+		template <>
+		inline s64		atom_int_type<s64>::load_relaxed() const
+		{
+			return read_s64_relaxed((s64 volatile*)&_data);
+		}
+
+		template <>
+		inline s64		atom_int_type<s64>::load_acquire() const
+		{
+			return read_s64_acquire((s64 volatile*)&_data);
+		}
+
 		template <>
-		inline bool		atom_int_type<u32>::bit_test_chg(u32 n)
+		inline void		atom_int_type<s64>::store_relaxed(s64 v)
 		{
-			u32 const i = (1<<n);
-			register u32 old;
-			do
-			{
-				old = read_u32((u32 volatile*)&_data);
-			} while (cas_u32(&_data, old, old ^ i) == false);
-			return (old & i) != 0;
+			write_s64_relaxed(&_data, v);
 		}
 
 		template <>
-		inline			atom_int_type<u32>::atom_int_type()							{ set(0); }
-		template <>
-		inline			atom_int_type<u32>::atom_int_type(const atom_int_type& i)	{ set(i.get()); }
-		template <>
-		inline			atom_int_type<u32>::atom_int_type(u32 i)					{ set(i); }
-
-		inline			atom_u32::atom_u32() : atom_int_type<u32>(0)				{ }
-		inline			atom_u32::atom_u32(u32 i) : atom_int_type<u32>(i)			{ }
-
-		/**
-		 * 64 bit signed integer
-		 */
-		class atom_s64 : public atom_int_type<s64>
+		inline void		atom_int_type<s64>::store_release(s64 v)
 		{
-		public:
-			atom_s64();
-			atom_s64(s64 i);
-		};
+			write_s64_release(&_data, v);
+		}
 
-		static inline s64	read_s64(s64 volatile* p)
+		template <>
+		inline bool		atom_int_type<s64>::cas(s64 old, s64 n)
 		{
-			return cpu_interlocked::sRead64((volatile u64*)p);
+			return cas_s64(&_data, old, n);
 		}
 
-		static inline void	write_s64(s64 volatile* p, s64 v)
+		template <>
+		inline bool		atom_int_type<s64>::cas_relaxed(s64 old, s64 n)
 		{
-			cpu_interlocked::sWrite64((volatile u64*)p, (u64)v);
+			return cas_s64_relaxed(&_data, old, n);
 		}
 
-		static inline bool	cas_s64(s64 volatile* mem, s64 old, s64 n)
+		template <>
+		inline bool		atom_int_type<s64>::cas_acquire(s64 old, s64 n)
 		{
-			s64 r = (s64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)mem, (u64)n, (u64)old);
-			return r == old;
+			return cas_s64_acquire(&_data, old, n);
 		}
 
-		static inline bool	cas_s64(volatile s64* mem, s32 ol, s32 oh, s32 nl, s32 nh)
+		template <>
+		inline bool		atom_int_type<s64>::cas_release(s64 old, s64 n)
 		{
-			u64 old = oh; old = old << 32; old = old | ol;
-			u64 n = nh; n = n << 32; n = n | nl;
-			s64 r = (s64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)mem, (u64)n, (u64)old);
-			return r == old;
+			return cas_s64_release(&_data, old, n);
 		}
 
-		/**
-		 * atomic integer base function implementations
-		 */
-
 		template <>
-		inline s64		atom_int_type<s64>::get() const
+		inline bool		atom_int_type<s64>::cas_acq_rel(s64 old, s64 n)
 		{
-			return read_s64((s64 volatile*)&_data); 
+			return cas_s64_acq_rel(&_data, old, n);
 		}
 
 		template <>
-		inline void		atom_int_type<s64>::set(s64 v)
+		inline bool		atom_int_type<s64>::compare_exchange(s64& expected, s64 n)
 		{
-			write_s64(&_data, v); 
+			s64 const old = (s64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)&_data, (u64)n, (u64)expected);
+			if (old == expected)
+				return true;
+			expected = old;
+			return false;
 		}
 
 		/**
@@ -686,7 +960,7 @@ namespace ncore
 		inline s64		atom_int_type<s64>::swap(s64 i)
 		{
 			/// Automatically locks when doing this op with a memory operand.
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -700,7 +974,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::incr()
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -713,7 +987,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<s64>::test_decr()
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -729,7 +1003,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<s64>::decr_test()
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -743,7 +1017,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::decr()
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -756,7 +1030,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::add(s64 i)
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -769,7 +1043,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::sub(s64 i)
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -779,7 +1053,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::bit_or(s64 i)
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -789,7 +1063,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::bit_xor(s64 i)
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -799,7 +1073,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<s64>::bit_and(s64 i)
 		{
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -810,7 +1084,7 @@ namespace ncore
 		inline void		atom_int_type<s64>::bit_set(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -821,7 +1095,7 @@ namespace ncore
 		inline void		atom_int_type<s64>::bit_clr(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -832,7 +1106,7 @@ namespace ncore
 		inline void		atom_int_type<s64>::bit_chg(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -843,7 +1117,7 @@ namespace ncore
 		inline bool		atom_int_type<s64>::bit_test_set(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -855,7 +1129,7 @@ namespace ncore
 		inline bool		atom_int_type<s64>::bit_test_clr(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -867,7 +1141,7 @@ namespace ncore
 		inline bool		atom_int_type<s64>::bit_test_chg(u32 n)
 		{
 			s64 const i = (1<<n);
-			register s64 old;
+			s64 old;
 			do
 			{
 				old = read_s64((s64 volatile*)&_data);
@@ -875,6 +1149,64 @@ namespace ncore
 			return (old & i) != 0;
 		}
 
+		/**
+		 * Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+		 */
+		template <>
+		inline s64		atom_int_type<s64>::exchange(s64 i)
+		{
+			s64 old;
+			do
+			{
+				old = read_s64((s64 volatile*)&_data);
+			} while (cas_s64(&_data, old, i) == false);
+			return old;
+		}
+
+		template <>
+		inline s64		atom_int_type<s64>::fetch_add(s64 i)
+		{
+			s64 old;
+			do
+			{
+				old = read_s64((s64 volatile*)&_data);
+			} while (cas_s64(&_data, old, old + i) == false);
+			return old;
+		}
+
+		template <>
+		inline s64		atom_int_type<s64>::fetch_sub(s64 i)
+		{
+			s64 old;
+			do
+			{
+				old = read_s64((s64 volatile*)&_data);
+			} while (cas_s64(&_data, old, old - i) == false);
+			return old;
+		}
+
+		template <>
+		inline s64		atom_int_type<s64>::fetch_or(s64 i)
+		{
+			s64 old;
+			do
+			{
+				old = read_s64((s64 volatile*)&_data);
+			} while (cas_s64(&_data, old, old | i) == false);
+			return old;
+		}
+
+		template <>
+		inline s64		atom_int_type<s64>::fetch_and(s64 i)
+		{
+			s64 old;
+			do
+			{
+				old = read_s64((s64 volatile*)&_data);
+			} while (cas_s64(&_data, old, old & i) == false);
+			return old;
+		}
+
 		template <>
 		inline			atom_int_type<s64>::atom_int_type()							{ set(0); }
 		template <>
@@ -919,6 +1251,34 @@ namespace ncore
 			return r == old;
 		}
 
+		// Memory order variants. Every locked instruction is a full barrier on x86, so the
+		// cas variants all map onto the same lock cmpxchg, only loads and stores differ.
+
+		static inline u64	read_u64_relaxed(u64 volatile* p)
+		{
+			return (u64)cpu_interlocked::sReadRelaxed64((u64 volatile*)p);
+		}
+
+		static inline u64	read_u64_acquire(u64 volatile* p)
+		{
+			return (u64)cpu_interlocked::sReadAcquire64((u64 volatile*)p);
+		}
+
+		static inline void	write_u64_relaxed(u64 volatile* p, u64 v)
+		{
+			cpu_interlocked::sWriteRelaxed64((u64 volatile*)p, (u64)v);
+		}
+
+		static inline void	write_u64_release(u64 volatile* p, u64 v)
+		{
+			cpu_interlocked::sWriteRelease64((u64 volatile*)p, (u64)v);
+		}
+
+		static inline bool	cas_u64_relaxed(u64 volatile* mem, u64 old, u64 n)	{ return cas_u64(mem, old, n); }
+		static inline bool	cas_u64_acquire(u64 volatile* mem, u64 old, u64 n)	{ return cas_u64(mem, old, n); }
+		static inline bool	cas_u64_release(u64 volatile* mem, u64 old, u64 n)	{ return cas_u64(mem, old, n); }
+		static inline bool	cas_u64_acq_rel(u64 volatile* mem, u64 old, u64 n)	{ return cas_u64(mem, old, n); }
+
 		/**
 		 * atomic integer base function implementations
 		 */
@@ -935,6 +1295,73 @@ namespace ncore
 			write_u64(&_data, v); 
 		}
 
+		/**
+		 * Memory order variants
+		 */
+		template <>
+		inline u64		atom_int_type<u64>::load_relaxed() const
+		{
+			return read_u64_relaxed((u64 volatile*)&_data);
+		}
+
+		template <>
+		inline u64		atom_int_type<u64>::load_acquire() const
+		{
+			return read_u64_acquire((u64 volatile*)&_data);
+		}
+
+		template <>
+		inline void		atom_int_type<u64>::store_relaxed(u64 v)
+		{
+			write_u64_relaxed(&_data, v);
+		}
+
+		template <>
+		inline void		atom_int_type<u64>::store_release(u64 v)
+		{
+			write_u64_release(&_data, v);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::cas(u64 old, u64 n)
+		{
+			return cas_u64(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::cas_relaxed(u64 old, u64 n)
+		{
+			return cas_u64_relaxed(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::cas_acquire(u64 old, u64 n)
+		{
+			return cas_u64_acquire(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::cas_release(u64 old, u64 n)
+		{
+			return cas_u64_release(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::cas_acq_rel(u64 old, u64 n)
+		{
+			return cas_u64_acq_rel(&_data, old, n);
+		}
+
+		template <>
+		inline bool		atom_int_type<u64>::compare_exchange(u64& expected, u64 n)
+		{
+			u64 const old = (u64)cpu_interlocked::sInterlockedCompareExchange64((u64 volatile*)&_data, (u64)n, (u64)expected);
+			if (old == expected)
+				return true;
+			expected = old;
+			return false;
+		}
+
 		/**
 		 * Swap and return old value
 		 */
@@ -942,7 +1369,7 @@ namespace ncore
 		inline u64		atom_int_type<u64>::swap(u64 i)
 		{
 			/// Automatically locks when doing this op with a memory operand.
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -956,7 +1383,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::incr()
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -969,7 +1396,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<u64>::test_decr()
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -985,7 +1412,7 @@ namespace ncore
 		template <>
 		inline bool		atom_int_type<u64>::decr_test()
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -999,7 +1426,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::decr()
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1012,7 +1439,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::add(u64 i)
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1025,7 +1452,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::sub(u64 i)
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1035,7 +1462,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::bit_or(u64 i)
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1045,7 +1472,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::bit_xor(u64 i)
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1055,7 +1482,7 @@ namespace ncore
 		template <>
 		inline void		atom_int_type<u64>::bit_and(u64 i)
 		{
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1066,7 +1493,7 @@ namespace ncore
 		inline void		atom_int_type<u64>::bit_set(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1077,7 +1504,7 @@ namespace ncore
 		inline void		atom_int_type<u64>::bit_clr(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1088,7 +1515,7 @@ namespace ncore
 		inline void		atom_int_type<u64>::bit_chg(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1099,7 +1526,7 @@ namespace ncore
 		inline bool		atom_int_type<u64>::bit_test_set(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1111,7 +1538,7 @@ namespace ncore
 		inline bool		atom_int_type<u64>::bit_test_clr(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1123,7 +1550,7 @@ namespace ncore
 		inline bool		atom_int_type<u64>::bit_test_chg(u32 n)
 		{
 			s64 const i = (1<<n);
-			register u64 old;
+			u64 old;
 			do
 			{
 				old = read_u64((u64 volatile*)&_data);
@@ -1131,6 +1558,64 @@ namespace ncore
 			return (old & i) != 0;
 		}
 
+		/**
+		 * Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+		 */
+		template <>
+		inline u64		atom_int_type<u64>::exchange(u64 i)
+		{
+			u64 old;
+			do
+			{
+				old = read_u64((u64 volatile*)&_data);
+			} while (cas_u64(&_data, old, i) == false);
+			return old;
+		}
+
+		template <>
+		inline u64		atom_int_type<u64>::fetch_add(u64 i)
+		{
+			u64 old;
+			do
+			{
+				old = read_u64((u64 volatile*)&_data);
+			} while (cas_u64(&_data, old, old + i) == false);
+			return old;
+		}
+
+		template <>
+		inline u64		atom_int_type<u64>::fetch_sub(u64 i)
+		{
+			u64 old;
+			do
+			{
+				old = read_u64((u64 volatile*)&_data);
+			} while (cas_u64(&_data, old, old - i) == false);
+			return old;
+		}
+
+		template <>
+		inline u64		atom_int_type<u64>::fetch_or(u64 i)
+		{
+			u64 old;
+			do
+			{
+				old = read_u64((u64 volatile*)&_data);
+			} while (cas_u64(&_data, old, old | i) == false);
+			return old;
+		}
+
+		template <>
+		inline u64		atom_int_type<u64>::fetch_and(u64 i)
+		{
+			u64 old;
+			do
+			{
+				old = read_u64((u64 volatile*)&_data);
+			} while (cas_u64(&_data, old, old & i) == false);
+			return old;
+		}
+
 		template <>
 		inline			atom_int_type<u64>::atom_int_type()							{ set(0); }
 		template <>
@@ -1141,5 +1626,211 @@ namespace ncore
 		inline			atom_u64::atom_u64() : atom_int_type<u64>(0)				{ }
 		inline			atom_u64::atom_u64(u64 i) : atom_int_type<u64>(i)			{ }
 
+
+		// 8 and 16 bit integers
+		// The _Interlocked*8 and *16 intrinsics exist on every x86 target, so one generic
+		// definition serves s8, u8, s16 and u16. The 32 and 64 bit types above use their
+		// own specializations, they take precedence over these.
+
+		namespace cpu_x86_32
+		{
+			template <class T> struct sUnsigned;
+			template <> struct sUnsigned<s8>		{ typedef u8	type; };
+			template <> struct sUnsigned<u8>		{ typedef u8	type; };
+			template <> struct sUnsigned<s16>		{ typedef u16	type; };
+			template <> struct sUnsigned<u16>		{ typedef u16	type; };
+
+			template <class T>
+			inline static volatile typename sUnsigned<T>::type* sSmall(T const volatile *p)
+			{
+				return (volatile typename sUnsigned<T>::type*)p;
+			}
+
+			inline static u8 sCompareExchange(volatile u8 *dest, u8 exchange, u8 comperand)		{ return (u8)::_InterlockedCompareExchange8((volatile char*)dest, (char)exchange, (char)comperand); }
+			inline static u16 sCompareExchange(volatile u16 *dest, u16 exchange, u16 comperand)	{ return (u16)::_InterlockedCompareExchange16((volatile short*)dest, (short)exchange, (short)comperand); }
+			inline static u8 sExchange(volatile u8 *dest, u8 v)									{ return (u8)::_InterlockedExchange8((volatile char*)dest, (char)v); }
+			inline static u16 sExchange(volatile u16 *dest, u16 v)								{ return (u16)::_InterlockedExchange16((volatile short*)dest, (short)v); }
+			inline static u8 sExchangeAdd(volatile u8 *dest, u8 v)								{ return (u8)::_InterlockedExchangeAdd8((volatile char*)dest, (char)v); }
+			inline static u16 sExchangeAdd(volatile u16 *dest, u16 v)							{ return (u16)::_InterlockedExchangeAdd16((volatile short*)dest, (short)v); }
+			inline static u8 sOr(volatile u8 *dest, u8 v)										{ return (u8)::_InterlockedOr8((volatile char*)dest, (char)v); }
+			inline static u16 sOr(volatile u16 *dest, u16 v)									{ return (u16)::_InterlockedOr16((volatile short*)dest, (short)v); }
+			inline static u8 sAnd(volatile u8 *dest, u8 v)										{ return (u8)::_InterlockedAnd8((volatile char*)dest, (char)v); }
+			inline static u16 sAnd(volatile u16 *dest, u16 v)									{ return (u16)::_InterlockedAnd16((volatile short*)dest, (short)v); }
+			inline static u8 sXor(volatile u8 *dest, u8 v)										{ return (u8)::_InterlockedXor8((volatile char*)dest, (char)v); }
+			inline static u16 sXor(volatile u16 *dest, u16 v)									{ return (u16)::_InterlockedXor16((volatile short*)dest, (short)v); }
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::get() const
+		{
+			return (T)cpu_interlocked::sCompareExchange(cpu_interlocked::sSmall(&_data), 0, 0);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::set(T v)
+		{
+			_ReadWriteBarrier();
+			_data = v;
+		}
+
+		// Memory order variants. Every locked instruction is a full barrier on x86, so the
+		// cas variants all map onto the same lock cmpxchg, only loads and stores differ.
+
+		template <class T>
+		inline T		atom_int_type<T>::load_relaxed() const						{ return _data; }
+		template <class T>
+		inline T		atom_int_type<T>::load_acquire() const						{ T v = _data; _ReadWriteBarrier(); return v; }
+		template <class T>
+		inline void		atom_int_type<T>::store_relaxed(T v)						{ _data = v; }
+		template <class T>
+		inline void		atom_int_type<T>::store_release(T v)						{ _ReadWriteBarrier(); _data = v; }
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas(T old, T n)
+		{
+			return (T)cpu_interlocked::sCompareExchange(cpu_interlocked::sSmall(&_data), n, old) == old;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::cas_relaxed(T old, T n)					{ return cas(old, n); }
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acquire(T old, T n)					{ return cas(old, n); }
+		template <class T>
+		inline bool		atom_int_type<T>::cas_release(T old, T n)					{ return cas(old, n); }
+		template <class T>
+		inline bool		atom_int_type<T>::cas_acq_rel(T old, T n)					{ return cas(old, n); }
+
+		template <class T>
+		inline bool		atom_int_type<T>::compare_exchange(T& expected, T n)
+		{
+			T const old = (T)cpu_interlocked::sCompareExchange(cpu_interlocked::sSmall(&_data), n, expected);
+			if (old == expected)
+				return true;
+			expected = old;
+			return false;
+		}
+
+		template <class T>
+		inline T		atom_int_type<T>::swap(T i)									{ return exchange(i); }
+
+		template <class T>
+		inline void		atom_int_type<T>::incr()									{ fetch_add((T)1); }
+
+		template <class T>
+		inline bool		atom_int_type<T>::test_decr()
+		{
+			T old;
+			do
+			{
+				old = load_relaxed();
+				if (old == 0)
+					return false;
+			} while (!cas(old, (T)(old - 1)));
+			return true;
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::decr_test()								{ return fetch_sub((T)1) != (T)1; }
+		template <class T>
+		inline void		atom_int_type<T>::decr()									{ fetch_sub((T)1); }
+		template <class T>
+		inline void		atom_int_type<T>::add(T i)									{ fetch_add(i); }
+		template <class T>
+		inline void		atom_int_type<T>::sub(T i)									{ fetch_sub(i); }
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_or(T i)								{ fetch_or(i); }
+		template <class T>
+		inline void		atom_int_type<T>::bit_xor(T i)								{ cpu_interlocked::sXor(cpu_interlocked::sSmall(&_data), i); }
+		template <class T>
+		inline void		atom_int_type<T>::bit_and(T i)								{ fetch_and(i); }
+
+		template <class T>
+		inline void		atom_int_type<T>::bit_set(u32 n)							{ fetch_or((T)(1 << n)); }
+		template <class T>
+		inline void		atom_int_type<T>::bit_clr(u32 n)							{ fetch_and((T)~(1 << n)); }
+		template <class T>
+		inline void		atom_int_type<T>::bit_chg(u32 n)							{ bit_xor((T)(1 << n)); }
+
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_set(u32 n)						{ T const i = (T)(1 << n); return (fetch_or(i) & i) != 0; }
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_clr(u32 n)						{ T const i = (T)(1 << n); return (fetch_and((T)~i) & i) != 0; }
+		template <class T>
+		inline bool		atom_int_type<T>::bit_test_chg(u32 n)
+		{
+			T const i = (T)(1 << n);
+			return ((T)cpu_interlocked::sXor(cpu_interlocked::sSmall(&_data), i) & i) != 0;
+		}
+
+		// Exchange, fetch_add, fetch_sub, fetch_or and fetch_and return the previous value
+
+		template <class T>
+		inline T		atom_int_type<T>::exchange(T i)								{ return (T)cpu_interlocked::sExchange(cpu_interlocked::sSmall(&_data), i); }
+		template <class T>
+		inline T		atom_int_type<T>::fetch_add(T i)							{ return (T)cpu_interlocked::sExchangeAdd(cpu_interlocked::sSmall(&_data), i); }
+		template <class T>
+		inline T		atom_int_type<T>::fetch_sub(T i)							{ return (T)cpu_interlocked::sExchangeAdd(cpu_interlocked::sSmall(&_data), (T)(0 - i)); }
+		template <class T>
+		inline T		atom_int_type<T>::fetch_or(T i)								{ return (T)cpu_interlocked::sOr(cpu_interlocked::sSmall(&_data), i); }
+		template <class T>
+		inline T		atom_int_type<T>::fetch_and(T i)							{ return (T)cpu_interlocked::sAnd(cpu_interlocked::sSmall(&_data), i); }
+
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type()							{ set(0); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(const atom_int_type& i)	{ set(i.get()); }
+		template <class T>
+		inline			atom_int_type<T>::atom_int_type(T i)						{ set(i); }
+
+
+		// 8 bit signed integer
+
+		class atom_s8 : public atom_int_type<s8>
+		{
+		public:
+			atom_s8();
+			atom_s8(s8 i);
+		};
+
+		inline			atom_s8::atom_s8() : atom_int_type<s8>(0)				{ }
+		inline			atom_s8::atom_s8(s8 i) : atom_int_type<s8>(i)			{ }
+
+		// 8 bit unsigned integer
+
+		class atom_u8 : public atom_int_type<u8>
+		{
+		public:
+			atom_u8();
+			atom_u8(u8 i);
+		};
+
+		inline			atom_u8::atom_u8() : atom_int_type<u8>(0)				{ }
+		inline			atom_u8::atom_u8(u8 i) : atom_int_type<u8>(i)			{ }
+
+		// 16 bit signed integer
+
+		class atom_s16 : public atom_int_type<s16>
+		{
+		public:
+			atom_s16();
+			atom_s16(s16 i);
+		};
+
+		inline			atom_s16::atom_s16() : atom_int_type<s16>(0)				{ }
+		inline			atom_s16::atom_s16(s16 i) : atom_int_type<s16>(i)			{ }
+
+		// 16 bit unsigned integer
+
+		class atom_u16 : public atom_int_type<u16>
+		{
+		public:
+			atom_u16();
+			atom_u16(u16 i);
+		};
+
+		inline			atom_u16::atom_u16() : atom_int_type<u16>(0)				{ }
+		inline			atom_u16::atom_u16(u16 i) : atom_int_type<u16>(i)			{ }
+
 	}
 }
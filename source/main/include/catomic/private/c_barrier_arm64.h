@@ -0,0 +1,30 @@
+/**
+ * @file catomic\private\c_barrier_arm64.h
+ * AArch64 specific barriers for GCC and Clang, only used with D_ATOMIC_ARM64.
+ * @warning do not include directly. @see catomic\c_barrier.h
+ */
+#include <sched.h>
+namespace ncore
+{
+	/**
+	 * We're using inline function here instead of #defines to avoid name space clashes.
+	 */
+	namespace barrier
+	{
+		/**
+		 * Memory barriers
+		 * Inner shareable domain only, that is all cores running this process.
+		 * dmb ishld orders earlier loads against later loads and stores.
+		 * dmb ishst orders earlier stores against later stores.
+		 * dmb ish is the full barrier.
+		 */
+		force_inline void comp()		{ __asm__ __volatile__("" ::: "memory"); }
+
+		force_inline void memr()		{ __asm__ __volatile__("dmb ishld" ::: "memory"); }
+		force_inline void memw()		{ __asm__ __volatile__("dmb ishst" ::: "memory"); }
+		force_inline void memrw()		{ __asm__ __volatile__("dmb ish" ::: "memory"); }
+
+		force_inline void pause()		{ __asm__ __volatile__("yield" ::: "memory"); }
+		force_inline void yield()		{ sched_yield(); }
+	}
+}
@@ -0,0 +1,49 @@
+/**
+ * @file catomic\private\c_barrier_std.h
+ * Portable barriers on top of C++11 std::atomic fences.
+ * Selected by defining D_ATOMIC_STD. @see catomic\private\c_atomic_std.h
+ * @warning do not include directly. @see catomic\c_barrier.h
+ */
+#include <atomic>
+#include <thread>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+namespace ncore
+{
+	/**
+	 * We're using inline function here instead of #defines to avoid name space clashes.
+	 */
+	namespace barrier
+	{
+		/**
+		 * Memory barriers
+		 * A signal fence only stops the compiler, the thread fences emit whatever
+		 * the target needs for acquire, release and full ordering.
+		 */
+		force_inline void comp()		{ std::atomic_signal_fence(std::memory_order_seq_cst); }
+
+		force_inline void memr()		{ std::atomic_thread_fence(std::memory_order_acquire); }
+		force_inline void memw()		{ std::atomic_thread_fence(std::memory_order_release); }
+		force_inline void memrw()		{ std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+		/**
+		 * There is no standard spin-wait hint, use the cpu one where it is known.
+		 */
+		force_inline void pause()
+		{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+			_mm_pause();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+			__builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+			__asm__ __volatile__("yield" ::: "memory");
+#else
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+		}
+
+		force_inline void yield()		{ std::this_thread::yield(); }
+	}
+}
@@ -0,0 +1,30 @@
+/**
+ * @file catomic\private\c_barrier_x86_linux64.h
+ * X86-64 specific barriers for GCC and Clang.
+ * @warning do not include directly. @see catomic\c_barrier.h
+ */
+#include <sched.h>
+namespace ncore
+{
+	/**
+	 * We're using inline function here instead of #defines to avoid name space clashes.
+	 */
+	namespace barrier
+	{
+		/**
+		 * Memory barriers
+		 * X86 does not reorder loads with loads or stores with stores (TSO), so the
+		 * read and write barriers only have to stop the compiler. Only a store
+		 * followed by a load can pass each other, which needs a real fence.
+		 * A locked add to the stack is cheaper than mfence on most cores.
+		 */
+		force_inline void comp()		{ __asm__ __volatile__("" ::: "memory"); }
+
+		force_inline void memr()		{ __asm__ __volatile__("" ::: "memory"); }
+		force_inline void memw()		{ __asm__ __volatile__("" ::: "memory"); }
+		force_inline void memrw()		{ __asm__ __volatile__("lock; addl $0,-4(%%rsp)" ::: "memory", "cc"); }
+
+		force_inline void pause()		{ __asm__ __volatile__("pause" ::: "memory"); }
+		force_inline void yield()		{ sched_yield(); }
+	}
+}
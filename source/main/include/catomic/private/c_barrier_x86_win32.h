@@ -3,6 +3,9 @@
  * X86 (32 and 64 bit) specific barriers.
  * @warning do not include directly. @see xatomic\x_barrier.h
  */
+#include <intrin.h>
+
+extern "C" __declspec(dllimport) int __stdcall SwitchToThread(void);
 
 namespace ncore
 {
@@ -20,5 +23,8 @@ namespace ncore
 		force_inline void barrier::memr()		{ __asm { __asm lfence }; }
 		force_inline void barrier::memw()		{ __asm { __asm sfence }; }
 		force_inline void barrier::memrw()		{ __asm { __asm mfence }; }
+
+		force_inline void barrier::pause()		{ _mm_pause(); }
+		force_inline void barrier::yield()		{ SwitchToThread(); }
 	}
 }
\ No newline at end of file
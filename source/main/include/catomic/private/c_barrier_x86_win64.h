@@ -4,6 +4,9 @@
  * @warning do not include directly. @see xatomic\x_barrier.h
  */
 #include <intrin.h>
+
+extern "C" __declspec(dllimport) int __stdcall SwitchToThread(void);
+
 namespace ncore
 {
 	/**
@@ -20,5 +23,8 @@ namespace ncore
 		force_inline void barrier::memr()		{ _ReadBarrier(); }
 		force_inline void barrier::memw()		{ _WriteBarrier(); }
 		force_inline void barrier::memrw()		{ _ReadWriteBarrier(); }
+
+		force_inline void barrier::pause()		{ _mm_pause(); }
+		force_inline void barrier::yield()		{ SwitchToThread(); }
 	}
 }
\ No newline at end of file
@@ -19,10 +19,53 @@
 	#ifndef force_inline
 		#define force_inline	f_inline
 	#endif
+
+	// Forced alignment of a type or variable
+	#ifndef force_align
+		#define force_align(n)	__declspec(align(n))
+	#endif
+#elif defined(__GNUC__)
+	// GCC and Clang
+
+	// Branch likely hood links
+	#ifndef likely
+		#define likely(x)    __builtin_expect(!!(x), 1)
+	#endif
+
+	#ifndef unlikely
+		#define unlikely(x)  __builtin_expect(!!(x), 0)
+	#endif
+
+	// Forced inlining 
+	#ifndef force_inline
+		#define force_inline	inline __attribute__((always_inline))
+	#endif
+
+	// Forced alignment of a type or variable
+	#ifndef force_align
+		#define force_align(n)	__attribute__((aligned(n)))
+	#endif
 #else
 	#error Unsupported CPU
 #endif
 
+// Size of a cache line, the unit at which cores invalidate each other's caches.
+// Apple silicon uses 128 byte lines, the other supported cpus 64.
+#ifndef DCORE_CACHELINE_SIZE
+	#if defined(__APPLE__) && defined(__aarch64__)
+		#define DCORE_CACHELINE_SIZE	128
+	#else
+		#define DCORE_CACHELINE_SIZE	64
+	#endif
+#endif
+
+// Start a type or member on its own cache line. Data written by different threads
+// should not share a line (false sharing), the aligned type is also padded up to a
+// multiple of the line size.
+#ifndef DCORE_CACHELINE_ALIGN
+	#define DCORE_CACHELINE_ALIGN	force_align(DCORE_CACHELINE_SIZE)
+#endif
+
 
 
 #endif // __CMULTICORE_COMPILER_H__
@@ -0,0 +1,72 @@
+#ifndef __CMULTICORE_CPU_PRIVATE_H__
+#define __CMULTICORE_CPU_PRIVATE_H__
+#include "ccore/c_target.h"
+#ifdef USE_PRAGMA_ONCE 
+#pragma once 
+#endif
+
+#include "catomic/private/c_compiler.h"
+
+#if defined(TARGET_LINUX)
+	#include <sched.h>
+	#include <unistd.h>
+#elif defined(TARGET_PC)
+	extern "C" __declspec(dllimport) unsigned long __stdcall GetCurrentProcessorNumber(void);
+	extern "C" __declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short group);
+#endif
+
+namespace ncore
+{
+	namespace atomic
+	{
+		namespace cpu_current
+		{
+			inline u32 sCount();
+
+			/**
+			 * Number of the cpu the calling thread is running on.
+			 * Only a hint, the thread can migrate right after the call. Where the
+			 * OS can not tell, a hash of the calling thread's stack is used so
+			 * that different threads still tend to get different numbers.
+			 */
+			force_inline u32 sIndex()
+			{
+#if defined(TARGET_LINUX)
+				int const c = sched_getcpu();
+				if (c >= 0)
+					return (u32)c;
+				// sched_getcpu() failed, the result still has to be below sCount()
+				u32 local;
+				xsize_t const s = (xsize_t)&local >> 16;
+				return (u32)(s ^ (s >> 8)) % sCount();
+#elif defined(TARGET_PC)
+				return (u32)GetCurrentProcessorNumber();
+#else
+				u32 local;
+				xsize_t const s = (xsize_t)&local >> 16;
+				return (u32)(s ^ (s >> 8));
+#endif
+			}
+
+			/**
+			 * Number of cpus configured in the system, on Linux and Windows sIndex()
+			 * is below it.
+			 * Returns 1 where the OS can not tell.
+			 */
+			inline u32 sCount()
+			{
+#if defined(TARGET_LINUX)
+				long const n = sysconf(_SC_NPROCESSORS_CONF);
+				return n > 0 ? (u32)n : 1;
+#elif defined(TARGET_PC)
+				// ALL_PROCESSOR_GROUPS
+				return (u32)GetActiveProcessorCount(0xffff);
+#else
+				return 1;
+#endif
+			}
+		}
+	}
+}
+
+#endif // __CMULTICORE_CPU_PRIVATE_H__
@@ -0,0 +1,55 @@
+/**
+ * @file catomic\private\c_membarrier_linux.h
+ * Asymmetric fences on Linux, membarrier(2).
+ * @warning do not include directly. @see catomic\c_barrier.h
+ */
+#include "ccore/c_debug.h"
+
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace ncore
+{
+	namespace barrier
+	{
+		namespace cpu_membarrier
+		{
+			inline static long sCall(int cmd)
+			{
+				return syscall(__NR_membarrier, cmd, 0, 0);
+			}
+
+			// The membarrier command for the heavy side, 0 when there is none. Selected
+			// once for the process while static objects are constructed (c_barrier.cpp),
+			// until then it reads 0 and both sides fence.
+			extern int const gCommand;
+		}
+
+		inline bool asymmetric_native()			{ return cpu_membarrier::gCommand != 0; }
+
+		// Without membarrier (kernels before 4.3) the heavy side can only fence the
+		// calling thread, so the light side has to be a full barrier as well.
+		force_inline void asymmetric_light()
+		{
+			if (cpu_membarrier::gCommand != 0)
+				comp();
+			else
+				memrw();
+		}
+
+		inline void asymmetric_heavy()
+		{
+			int const cmd = cpu_membarrier::gCommand;
+			if (cmd == 0)
+			{
+				memrw();
+				return;
+			}
+			// The light side is only a compiler barrier from here on, a fence on this
+			// thread alone would not order the others
+			long const r = cpu_membarrier::sCall(cmd);
+			ASSERTS(r == 0, "ncore::barrier::asymmetric_heavy: Error, membarrier failed after it was selected");
+			(void)r;
+		}
+	}
+}
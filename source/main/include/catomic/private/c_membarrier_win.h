@@ -0,0 +1,21 @@
+/**
+ * @file catomic\private\c_membarrier_win.h
+ * Asymmetric fences on Windows, FlushProcessWriteBuffers.
+ * @warning do not include directly. @see catomic\c_barrier.h
+ */
+
+#include <intrin.h>
+
+extern "C" __declspec(dllimport) void __stdcall FlushProcessWriteBuffers(void);
+
+namespace ncore
+{
+	namespace barrier
+	{
+		// FlushProcessWriteBuffers interrupts every cpu running a thread of this
+		// process, which acts as a full barrier on each of them.
+		inline bool asymmetric_native()			{ return true; }
+		force_inline void asymmetric_light()	{ _ReadWriteBarrier(); }
+		inline void asymmetric_heavy()			{ FlushProcessWriteBuffers(); }
+	}
+}
@@ -0,0 +1,228 @@
+/**
+ * @file catomic\private\c_percpu_rseq_x86_linux64.h
+ * Restartable sequences (rseq) for X86-64 Linux, GCC and Clang.
+ * @warning do not include directly. @see catomic\c_percpu.h
+ */
+
+#include <stddef.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#if !defined(__NR_rseq)
+	#define __NR_rseq	334
+#endif
+
+// Set by glibc 2.35 and later when it registered an rseq area for every thread,
+// weak so that older C libraries still link.
+extern "C"
+{
+	extern const ptrdiff_t		__rseq_offset __attribute__((weak));
+	extern const unsigned int	__rseq_size __attribute__((weak));
+}
+
+namespace ncore
+{
+	namespace atomic
+	{
+		namespace cpu_rseq
+		{
+			// Layout of the kernel's struct rseq (original 32 byte ABI)
+			struct area
+			{
+				u32			cpu_id_start;
+				u32			cpu_id;
+				u64			rseq_cs;
+				u32			flags;
+				u32			padding[3];
+			} __attribute__((aligned(32)));
+
+			enum
+			{
+				SIGNATURE = 0x53053053,
+				FLAG_UNREGISTER = 1,
+
+				MODE_NONE = 0,		// the kernel has no rseq, use the atomic fallback
+				MODE_LIBC = 1,		// the C library registered an area for every thread
+				MODE_OWN = 2,		// every thread registers sOwnArea() on first use
+
+				CPU_ID_FAILED = 0xfffffffe,	// RSEQ_CPU_ID_REGISTRATION_FAILED
+			};
+
+			// Area of the calling thread when the C library does not provide one
+			inline area&	sOwnArea()
+			{
+				static __thread area a = { 0, (u32)-1, 0, 0, { 0, 0, 0 } };
+				return a;
+			}
+
+			inline char*	sThreadPointer()
+			{
+				char* tp;
+				__asm__ ("movq %%fs:0, %0" : "=r"(tp));
+				return tp;
+			}
+
+			// A failed registration is remembered in cpu_id, the kernel refuses it for
+			// good when the thread has an area registered elsewhere (EBUSY).
+			inline bool		sRegisterOwn()
+			{
+				area& a = sOwnArea();
+				if ((s32)a.cpu_id >= 0)
+					return true;
+				if (a.cpu_id == CPU_ID_FAILED)
+					return false;
+				if (syscall(__NR_rseq, &a, sizeof(area), 0, SIGNATURE) == 0)
+					return true;
+				a.cpu_id = CPU_ID_FAILED;
+				return false;
+			}
+
+			inline s32		sDetect()
+			{
+				if (&__rseq_size != NULL && __rseq_size > 0)
+					return MODE_LIBC;
+				if (sRegisterOwn())
+					return MODE_OWN;
+				return MODE_NONE;
+			}
+
+			// Decided once for the whole process, rseq and atomic updates of the same
+			// per-cpu data must never be mixed.
+			inline s32		sMode()
+			{
+				static s32 const mode = sDetect();
+				return mode;
+			}
+
+			// Offset of the calling thread's area from the thread pointer, the
+			// critical sections address it through %fs.
+			inline ptrdiff_t	sOffset()
+			{
+				if (sMode() == MODE_LIBC)
+					return __rseq_offset;
+				return (char*)&sOwnArea() - sThreadPointer();
+			}
+
+			inline area volatile*	sArea()										{ return (area volatile*)(sThreadPointer() + sOffset()); }
+
+			// Whether the kernel keeps the calling thread's area up to date. The mode is
+			// per process but registration is per thread and can fail for a single
+			// thread, in MODE_OWN the first call registers the thread.
+			inline bool		sRegistered()
+			{
+				switch (sMode())
+				{
+				case MODE_LIBC:
+					return (s32)sArea()->cpu_id >= 0;
+				case MODE_OWN:
+					return sRegisterOwn();
+				}
+				return false;
+			}
+
+			// Only for a thread for which sRegistered() is true
+			inline u32		sCpu()													{ return sArea()->cpu_id_start; }
+
+			inline void		sUnregister()
+			{
+				if (sMode() != MODE_OWN)
+					return;
+				area& a = sOwnArea();
+				if ((s32)a.cpu_id < 0)
+					return;
+				if (syscall(__NR_rseq, &a, sizeof(area), FLAG_UNREGISTER, SIGNATURE) == 0)
+					a.cpu_id = (u32)-1;
+			}
+
+			// The critical sections below follow the layout that the kernel expects.
+			// A struct rseq_cs descriptor in section __rseq_cs (label 3) holds the start,
+			// the length up to the commit (labels 1 to 2) and the abort handler (label 4).
+			// Storing its address in rseq_cs arms the sequence, the cpu check makes sure
+			// the thread is still on 'cpu', and the final store is the commit. When the
+			// thread is preempted, migrated or gets a signal in between, the kernel moves
+			// it to the abort handler, which is preceded by the signature.
+
+			#define D_RSEQ_BEGIN															\
+				".pushsection __rseq_cs, \"aw\"\n\t"									\
+				".balign 32\n\t"														\
+				"3:\n\t"																\
+				".long 0x0, 0x0\n\t"													\
+				".quad 1f, (2f - 1f), 4f\n\t"											\
+				".popsection\n\t"														\
+				"leaq 3b(%%rip), %%rax\n\t"											\
+				"movq %%rax, %%fs:8(%[off])\n\t"										\
+				"1:\n\t"																\
+				"cmpl %[cpu], %%fs:4(%[off])\n\t"										\
+				"jnz 4f\n\t"
+
+			#define D_RSEQ_END																\
+				"2:\n\t"																\
+				".pushsection __rseq_failure, \"ax\"\n\t"								\
+				".byte 0x0f, 0xb9, 0x3d\n\t"											\
+				".long 0x53053053\n\t"													\
+				"4:\n\t"																\
+				"jmp %l[abort]\n\t"													\
+				".popsection\n\t"
+
+			inline s32		sAdd(u32 cpu, s64* v, s64 count)
+			{
+				__asm__ __volatile__ goto (
+					D_RSEQ_BEGIN
+					"addq %[count], %[v]\n\t"
+					D_RSEQ_END
+					:
+					: [cpu] "r"(cpu), [off] "r"(sOffset()), [v] "m"(*v), [count] "er"(count)
+					: "memory", "cc", "rax"
+					: abort);
+				return 0;
+			abort:
+				return -1;
+			}
+
+			inline s32		sCmpxchg(u32 cpu, s64* v, s64 expected, s64 desired)
+			{
+				__asm__ __volatile__ goto (
+					D_RSEQ_BEGIN
+					"cmpq %[v], %[expected]\n\t"
+					"jnz %l[cmpfail]\n\t"
+					"movq %[desired], %[v]\n\t"
+					D_RSEQ_END
+					:
+					: [cpu] "r"(cpu), [off] "r"(sOffset()), [v] "m"(*v), [expected] "r"(expected), [desired] "r"(desired)
+					: "memory", "cc", "rax"
+					: abort, cmpfail);
+				return 0;
+			abort:
+				return -1;
+			cmpfail:
+				return 1;
+			}
+
+			// Pop the first node, its next pointer is at offset 0
+			inline s32		sPop(u32 cpu, void** head, void** node)
+			{
+				__asm__ __volatile__ goto (
+					D_RSEQ_BEGIN
+					"movq %[head], %%rbx\n\t"
+					"testq %%rbx, %%rbx\n\t"
+					"jz %l[empty]\n\t"
+					"movq %%rbx, %[node]\n\t"
+					"movq (%%rbx), %%rbx\n\t"
+					"movq %%rbx, %[head]\n\t"
+					D_RSEQ_END
+					:
+					: [cpu] "r"(cpu), [off] "r"(sOffset()), [head] "m"(*head), [node] "m"(*node)
+					: "memory", "cc", "rax", "rbx"
+					: abort, empty);
+				return 0;
+			abort:
+				return -1;
+			empty:
+				return 1;
+			}
+
+			#undef D_RSEQ_BEGIN
+			#undef D_RSEQ_END
+		}
+	}
+}
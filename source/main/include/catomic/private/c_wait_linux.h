@@ -0,0 +1,94 @@
+/**
+ * @file catomic\private\c_wait_linux.h
+ * Blocking wait and notify on 32 bit atomics, Linux futex(2).
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+namespace ncore
+{
+	namespace atomic
+	{
+		// The futex word is private to this process, which skips the shared
+		// key lookup in the kernel.
+		namespace cpu_wait
+		{
+			// Only 32 bit words can be waited on, other sizes do not compile
+			template <u32 N> struct sCheckSize;
+			template <> struct sCheckSize<4>	{ static void valid() { } };
+
+			// Sleep while *addr == expected, returns on wake-up, value change or signal.
+			inline static void sWait(u32 volatile *addr, u32 expected)
+			{
+				syscall(SYS_futex, (u32*)addr, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+			}
+
+			// Same as sWait with an absolute CLOCK_MONOTONIC deadline, so that
+			// repeated waits do not stretch the timeout.
+			// Returns false when the deadline has passed.
+			inline static bool sWaitUntil(u32 volatile *addr, u32 expected, struct timespec const& deadline)
+			{
+				long const r = syscall(SYS_futex, (u32*)addr, FUTEX_WAIT_BITSET_PRIVATE, expected, &deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+				return !(r == -1 && errno == ETIMEDOUT);
+			}
+
+			inline static void sDeadline(u64 timeout_ns, struct timespec& deadline)
+			{
+				clock_gettime(CLOCK_MONOTONIC, &deadline);
+				u64 const ns = (u64)deadline.tv_nsec + (timeout_ns % 1000000000);
+				deadline.tv_sec += (time_t)(timeout_ns / 1000000000) + (time_t)(ns / 1000000000);
+				deadline.tv_nsec = (long)(ns % 1000000000);
+			}
+
+			inline static void sWake(u32 volatile *addr, s32 count)
+			{
+				syscall(SYS_futex, (u32*)addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+			}
+		}
+
+
+		// Blocking wait and notify, 32 bit only
+
+		template <class T>
+		inline void		atom_int_type<T>::wait(T expected) const
+		{
+			cpu_wait::sCheckSize<sizeof(T)>::valid();
+			while (load_acquire() == expected)
+				cpu_wait::sWait((u32 volatile*)&_data, (u32)expected);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::wait_for(T expected, u64 timeout_ns) const
+		{
+			cpu_wait::sCheckSize<sizeof(T)>::valid();
+			if (load_acquire() != expected)
+				return true;
+
+			struct timespec deadline;
+			cpu_wait::sDeadline(timeout_ns, deadline);
+			while (load_acquire() == expected)
+			{
+				if (!cpu_wait::sWaitUntil((u32 volatile*)&_data, (u32)expected, deadline))
+					return load_acquire() != expected;
+			}
+			return true;
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::notify_one()
+		{
+			cpu_wait::sWake((u32 volatile*)&_data, 1);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::notify_all()
+		{
+			cpu_wait::sWake((u32 volatile*)&_data, INT_MAX);
+		}
+	}
+}
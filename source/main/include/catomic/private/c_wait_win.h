@@ -0,0 +1,88 @@
+/**
+ * @file catomic\private\c_wait_win.h
+ * Blocking wait and notify on 32 bit atomics, WaitOnAddress (Windows 8 and later).
+ * @warning do not include directly. @see catomic\c_atomic.h
+ */
+#pragma comment(lib, "Synchronization.lib")
+
+extern "C" __declspec(dllimport) int __stdcall WaitOnAddress(volatile void* address, void* compare, ncore::xsize_t size, unsigned long milliseconds);
+extern "C" __declspec(dllimport) void __stdcall WakeByAddressSingle(void* address);
+extern "C" __declspec(dllimport) void __stdcall WakeByAddressAll(void* address);
+extern "C" __declspec(dllimport) unsigned long long __stdcall GetTickCount64(void);
+
+namespace ncore
+{
+	namespace atomic
+	{
+		namespace cpu_wait
+		{
+			// Only 32 bit words can be waited on, other sizes do not compile
+			template <u32 N> struct sCheckSize;
+			template <> struct sCheckSize<4>	{ static void valid() { } };
+
+			// Sleep while *addr == expected, returns on wake-up or value change.
+			inline static void sWait(u32 volatile *addr, u32 expected)
+			{
+				WaitOnAddress(addr, &expected, sizeof(u32), 0xffffffff);
+			}
+
+			// Returns false on timeout
+			inline static bool sWaitMs(u32 volatile *addr, u32 expected, u32 ms)
+			{
+				return WaitOnAddress(addr, &expected, sizeof(u32), ms) != 0;
+			}
+
+			inline static void sWakeOne(u32 volatile *addr)
+			{
+				WakeByAddressSingle((void*)addr);
+			}
+
+			inline static void sWakeAll(u32 volatile *addr)
+			{
+				WakeByAddressAll((void*)addr);
+			}
+		}
+
+
+		// Blocking wait and notify, 32 bit only
+
+		template <class T>
+		inline void		atom_int_type<T>::wait(T expected) const
+		{
+			cpu_wait::sCheckSize<sizeof(T)>::valid();
+			while (load_acquire() == expected)
+				cpu_wait::sWait((u32 volatile*)&_data, (u32)expected);
+		}
+
+		template <class T>
+		inline bool		atom_int_type<T>::wait_for(T expected, u64 timeout_ns) const
+		{
+			cpu_wait::sCheckSize<sizeof(T)>::valid();
+			if (load_acquire() != expected)
+				return true;
+
+			// Millisecond resolution, round up so that a short timeout still sleeps
+			u64 const deadline = GetTickCount64() + (timeout_ns + 999999) / 1000000;
+			while (load_acquire() == expected)
+			{
+				u64 const now = GetTickCount64();
+				if (now >= deadline)
+					return false;
+				cpu_wait::sWaitMs((u32 volatile*)&_data, (u32)expected, (u32)(deadline - now));
+			}
+			return true;
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::notify_one()
+		{
+			cpu_wait::sWakeOne((u32 volatile*)&_data);
+		}
+
+		template <class T>
+		inline void		atom_int_type<T>::notify_all()
+		{
+			cpu_wait::sWakeAll((u32 volatile*)&_data);
+		}
+	}
+}
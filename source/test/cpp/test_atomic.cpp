@@ -1,6 +1,10 @@
 #include "cunittest/cunittest.h"
 
 #include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+
+#include <chrono>
+#include <thread>
 
 UNITTEST_SUITE_BEGIN(atomic)
 {
@@ -120,6 +124,128 @@ UNITTEST_SUITE_BEGIN(atomic)
 				i.sub(159);
 			}
 		}
+
+		UNITTEST_TEST(fetch_min_max)
+		{
+			aint i(5);
+			CHECK_EQUAL(5, i.fetch_max(3));
+			CHECK_EQUAL(5, i.get());
+			CHECK_EQUAL(5, i.fetch_max(9));
+			CHECK_EQUAL(9, i.fetch_min(-4));
+			CHECK_EQUAL(-4, i.fetch_min(0));
+			CHECK_EQUAL(-4, i.get());
+		}
+
+		UNITTEST_TEST(fetch_ops)
+		{
+			aint i(5);
+			CHECK_EQUAL(5, i.fetch_add(3));
+			CHECK_EQUAL(8, i.fetch_sub(2));
+			CHECK_EQUAL(6, i.fetch_or(9));
+			CHECK_EQUAL(15, i.fetch_and(3));
+			CHECK_EQUAL(3, i.exchange(-1));
+			CHECK_EQUAL(-1, i.get());
+		}
+
+		UNITTEST_TEST(memory_order)
+		{
+			aint i(1);
+			CHECK_EQUAL(1, i.load_relaxed());
+			CHECK_EQUAL(1, i.load_acquire());
+			i.store_relaxed(2);
+			CHECK_EQUAL(2, i.get());
+			i.store_release(3);
+			CHECK_EQUAL(3, i.get());
+
+			CHECK_FALSE(i.cas(2, 4));
+			CHECK_TRUE(i.cas(3, 4));
+			CHECK_TRUE(i.cas_relaxed(4, 5));
+			CHECK_TRUE(i.cas_acquire(5, 6));
+			CHECK_TRUE(i.cas_release(6, 7));
+			CHECK_TRUE(i.cas_acq_rel(7, 8));
+			CHECK_FALSE(i.cas_acq_rel(7, 9));
+			CHECK_EQUAL(8, i.get());
+		}
+	}
+	
+	UNITTEST_FIXTURE(atom_u32)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::atom_u32	aint;
+
+		UNITTEST_TEST(fetch_min_max)
+		{
+			// Unsigned compare, 0xffffffff is the largest value
+			aint i(5);
+			CHECK_EQUAL(5u, i.fetch_max(0xffffffff));
+			CHECK_EQUAL(0xffffffff, i.fetch_min(6));
+			CHECK_EQUAL(6u, i.fetch_min(7));
+			CHECK_EQUAL(6u, i.get());
+		}
+
+		UNITTEST_TEST(bit_or_and_xor)
+		{
+			aint i(0);
+			i.bit_or(0x0f);
+			CHECK_EQUAL(0x0fu, i.get());
+			i.bit_and(0x3c);
+			CHECK_EQUAL(0x0cu, i.get());
+			i.bit_xor(0xff);
+			CHECK_EQUAL(0xf3u, i.get());
+		}
+
+		UNITTEST_TEST(bit_set_clr_chg)
+		{
+			aint i(0);
+			i.bit_set(31);
+			CHECK_EQUAL(0x80000000u, i.get());
+			i.bit_chg(0);
+			CHECK_EQUAL(0x80000001u, i.get());
+			i.bit_clr(31);
+			CHECK_EQUAL(0x00000001u, i.get());
+		}
+
+		UNITTEST_TEST(bit_test)
+		{
+			aint i(0);
+			CHECK_FALSE(i.bit_test_set(5));
+			CHECK_TRUE(i.bit_test_set(5));
+			CHECK_TRUE(i.bit_test_chg(5));
+			CHECK_FALSE(i.bit_test_chg(5));
+			CHECK_TRUE(i.bit_test_clr(5));
+			CHECK_FALSE(i.bit_test_clr(5));
+			CHECK_EQUAL(0u, i.get());
+		}
+
+		UNITTEST_TEST(free_functions)
+		{
+			ncore::u32 volatile v = 1;
+			CHECK_EQUAL(1u, ncore::atomic::read_u32_relaxed(&v));
+			CHECK_EQUAL(1u, ncore::atomic::read_u32_acquire(&v));
+			ncore::atomic::write_u32_relaxed(&v, 2);
+			CHECK_EQUAL(2u, ncore::atomic::read_u32(&v));
+			ncore::atomic::write_u32_release(&v, 3);
+			CHECK_EQUAL(3u, ncore::atomic::read_u32(&v));
+			CHECK_TRUE(ncore::atomic::cas_u32_relaxed(&v, 3, 4));
+			CHECK_TRUE(ncore::atomic::cas_u32_acquire(&v, 4, 5));
+			CHECK_TRUE(ncore::atomic::cas_u32_release(&v, 5, 6));
+			CHECK_TRUE(ncore::atomic::cas_u32_acq_rel(&v, 6, 7));
+			CHECK_FALSE(ncore::atomic::cas_u32_acquire(&v, 6, 8));
+			CHECK_EQUAL(7u, ncore::atomic::read_u32(&v));
+		}
+
+		UNITTEST_TEST(compare_exchange)
+		{
+			aint i(7);
+			ncore::u32 e = 6;
+			CHECK_FALSE(i.compare_exchange(e, 8));
+			CHECK_EQUAL(7u, e);
+			CHECK_TRUE(i.compare_exchange(e, 8));
+			CHECK_EQUAL(7u, e);
+			CHECK_EQUAL(8u, i.get());
+		}
 	}
 	
 	UNITTEST_FIXTURE(atom_s64)
@@ -225,6 +351,491 @@ UNITTEST_SUITE_BEGIN(atomic)
 				i.sub(159);
 			}
 		}
+
+		UNITTEST_TEST(fetch_min_max)
+		{
+			aint i(5);
+			CHECK_EQUAL(5, i.fetch_max(0x100000000LL));
+			CHECK_EQUAL(0x100000000LL, i.fetch_min(-4));
+			CHECK_EQUAL(-4, i.get());
+
+			ncore::atomic::atom_u64 u(5);
+			CHECK_EQUAL(5, u.fetch_max(0xffffffffffffffffULL));
+			CHECK_EQUAL(0xffffffffffffffffULL, u.fetch_min(7));
+			CHECK_EQUAL(7, u.get());
+		}
+
+		UNITTEST_TEST(fetch_ops)
+		{
+			aint i(5);
+			CHECK_EQUAL(5, i.fetch_add(3));
+			CHECK_EQUAL(8, i.fetch_sub(2));
+			CHECK_EQUAL(6, i.fetch_or(9));
+			CHECK_EQUAL(15, i.fetch_and(3));
+			CHECK_EQUAL(3, i.exchange(-1));
+			CHECK_EQUAL(-1, i.get());
+		}
+
+		UNITTEST_TEST(memory_order)
+		{
+			aint i(1);
+			CHECK_EQUAL(1, i.load_relaxed());
+			CHECK_EQUAL(1, i.load_acquire());
+			i.store_relaxed(2);
+			CHECK_EQUAL(2, i.get());
+			i.store_release(3);
+			CHECK_EQUAL(3, i.get());
+
+			CHECK_FALSE(i.cas(2, 4));
+			CHECK_TRUE(i.cas(3, 4));
+			CHECK_TRUE(i.cas_relaxed(4, 5));
+			CHECK_TRUE(i.cas_acquire(5, 6));
+			CHECK_TRUE(i.cas_release(6, 7));
+			CHECK_TRUE(i.cas_acq_rel(7, 8));
+			CHECK_FALSE(i.cas_acq_rel(7, 9));
+			CHECK_EQUAL(8, i.get());
+		}
+	}
+	
+	UNITTEST_FIXTURE(atom_small)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		UNITTEST_TEST(size)
+		{
+			CHECK_EQUAL(1, (ncore::s32)sizeof(ncore::atomic::atom_u8));
+			CHECK_EQUAL(1, (ncore::s32)sizeof(ncore::atomic::atom_s8));
+			CHECK_EQUAL(2, (ncore::s32)sizeof(ncore::atomic::atom_u16));
+			CHECK_EQUAL(2, (ncore::s32)sizeof(ncore::atomic::atom_s16));
+			CHECK_EQUAL(1, (ncore::s32)sizeof(ncore::atomic::atom_flag));
+
+			ncore::atomic::atom_u8 states[64];
+			CHECK_EQUAL(64, (ncore::s32)sizeof(states));
+		}
+
+		UNITTEST_TEST(u8)
+		{
+			ncore::atomic::atom_u8 i;
+			CHECK_EQUAL(0, i.get());
+			i.set(254);
+			i.incr();
+			CHECK_EQUAL(255, i.get());
+			i.incr();
+			CHECK_EQUAL(0, i.get());
+			CHECK_FALSE(i.test_decr());
+			CHECK_EQUAL(0, i.fetch_add(10));
+			CHECK_EQUAL(10, i.fetch_sub(3));
+			CHECK_TRUE(i.cas(7, 200));
+			CHECK_FALSE(i.cas(7, 1));
+			CHECK_EQUAL(200, i.fetch_max(100));
+			CHECK_EQUAL(200, i.fetch_min(100));
+			CHECK_EQUAL(100, i.exchange(0x0f));
+			CHECK_EQUAL(0x0f, i.fetch_or(0xf0));
+			CHECK_EQUAL(0xff, i.fetch_and(0x3c));
+			CHECK_EQUAL(0x3c, i.get());
+		}
+
+		UNITTEST_TEST(s8)
+		{
+			ncore::atomic::atom_s8 i(-1);
+			CHECK_EQUAL(-1, i.get());
+			i.add(-127);
+			CHECK_EQUAL(-128, i.get());
+			CHECK_EQUAL(-128, i.fetch_max(5));
+			CHECK_EQUAL(5, i.fetch_min(-3));
+			i.sub(2);
+			CHECK_EQUAL(-5, i.get());
+			CHECK_TRUE(i.decr_test());
+			CHECK_EQUAL(-6, i.load_acquire());
+		}
+
+		UNITTEST_TEST(u16_bits)
+		{
+			ncore::atomic::atom_u16 i;
+			CHECK_FALSE(i.bit_test_set(15));
+			CHECK_TRUE(i.bit_test_set(15));
+			i.bit_set(3);
+			CHECK_EQUAL(0x8008, i.get());
+			CHECK_TRUE(i.bit_test_chg(3));
+			CHECK_EQUAL(0x8000, i.get());
+			CHECK_TRUE(i.bit_test_clr(15));
+			CHECK_FALSE(i.bit_test_clr(15));
+			i.bit_chg(0);
+			i.bit_or(0x0100);
+			i.bit_xor(0x0101);
+			CHECK_EQUAL(0, i.get());
+			i.store_release(0xffff);
+			i.decr();
+			CHECK_EQUAL(0xfffe, i.load_relaxed());
+		}
+
+		UNITTEST_TEST(s16)
+		{
+			ncore::atomic::atom_s16 i(1000);
+			CHECK_EQUAL(1000, i.swap(-1000));
+			CHECK_TRUE(i.cas_acq_rel(-1000, 32767));
+			i.incr();
+			CHECK_EQUAL(-32768, i.get());
+		}
+
+		UNITTEST_TEST(flag)
+		{
+			ncore::atomic::atom_flag f;
+			CHECK_FALSE(f.test());
+			CHECK_FALSE(f.test_and_set());
+			CHECK_TRUE(f.test_and_set());
+			CHECK_TRUE(f.test());
+			f.clear();
+			CHECK_FALSE(f.test());
+		}
+
+		UNITTEST_TEST(atom_2)
+		{
+			struct pair8 { ncore::u8 index; ncore::u8 tag; };
+			pair8 v = { 1, 2 };
+			ncore::atomic::atom<pair8> a(v);
+			pair8 n = { 3, 4 };
+			CHECK_TRUE(a.compare_exchange(v, n));
+			CHECK_EQUAL(3, a.load().index);
+			CHECK_EQUAL(4, a.load().tag);
+		}
+	}
+
+	UNITTEST_FIXTURE(atom_u128)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::atom_u128	aint;
+		typedef ncore::atomic::u128			u128;
+
+		UNITTEST_TEST(construct)
+		{
+			aint i;
+			CHECK_EQUAL(0, i.get().lo);
+			CHECK_EQUAL(0, i.get().hi);
+
+			aint i2(1, 2);
+			CHECK_EQUAL(1, i2.get().lo);
+			CHECK_EQUAL(2, i2.get().hi);
+		}
+
+		UNITTEST_TEST(set_swap)
+		{
+			aint i;
+			u128 v = { 0x1111111111111111ULL, 0x2222222222222222ULL };
+			i.set(v);
+			CHECK_EQUAL(v.lo, i.get().lo);
+			CHECK_EQUAL(v.hi, i.get().hi);
+
+			u128 w = { 3, 4 };
+			u128 o = i.swap(w);
+			CHECK_EQUAL(v.lo, o.lo);
+			CHECK_EQUAL(v.hi, o.hi);
+			CHECK_EQUAL(3, i.get().lo);
+			CHECK_EQUAL(4, i.get().hi);
+		}
+
+		UNITTEST_TEST(cas)
+		{
+			aint i(1, 2);
+			CHECK_FALSE(i.cas(1, 3, 5, 6));
+			CHECK_FALSE(i.cas(3, 2, 5, 6));
+			CHECK_TRUE(i.cas(1, 2, 5, 6));
+
+			u128 o = { 5, 6 };
+			u128 n = { 0xffffffffffffffffULL, 7 };
+			CHECK_TRUE(i.cas(o, n));
+			CHECK_FALSE(i.cas(o, n));
+			CHECK_EQUAL(n.lo, i.get().lo);
+			CHECK_EQUAL(n.hi, i.get().hi);
+		}
+
+		UNITTEST_TEST(free_functions)
+		{
+			u128 volatile v = { 1, 2 };
+			u128 r = ncore::atomic::read_u128(&v);
+			CHECK_EQUAL(1, r.lo);
+			CHECK_EQUAL(2, r.hi);
+
+			u128 w = { 3, 4 };
+			ncore::atomic::write_u128(&v, w);
+			CHECK_TRUE(ncore::atomic::cas_u128(&v, 3, 4, 5, 6));
+			CHECK_EQUAL(5, v.lo);
+			CHECK_EQUAL(6, v.hi);
+		}
+	}
+
+	UNITTEST_FIXTURE(atom)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		struct pair16 { ncore::u16 index; ncore::u16 tag; };
+		struct pair32 { ncore::u32 index; ncore::u32 tag; };
+		struct ptr_tag { void* ptr; ncore::u64 tag; };
+
+		UNITTEST_TEST(size_4)
+		{
+			ncore::atomic::atom<pair16> a;
+			CHECK_EQUAL(0, a.load().index);
+			CHECK_EQUAL(0, a.load().tag);
+
+			pair16 v = { 1, 2 };
+			a.store(v);
+			CHECK_EQUAL(1, a.load().index);
+			CHECK_EQUAL(2, a.load().tag);
+
+			pair16 w = { 3, 4 };
+			pair16 o = a.exchange(w);
+			CHECK_EQUAL(1, o.index);
+			CHECK_EQUAL(2, o.tag);
+			CHECK_EQUAL(3, a.load().index);
+		}
+
+		UNITTEST_TEST(size_8)
+		{
+			pair32 v = { 10, 20 };
+			ncore::atomic::atom<pair32> a(v);
+
+			pair32 e = { 10, 21 };
+			pair32 n = { 11, 22 };
+			CHECK_FALSE(a.compare_exchange(e, n));
+			CHECK_EQUAL(10, e.index);
+			CHECK_EQUAL(20, e.tag);
+
+			CHECK_TRUE(a.compare_exchange(e, n));
+			CHECK_EQUAL(11, a.load().index);
+			CHECK_EQUAL(22, a.load().tag);
+		}
+
+		UNITTEST_TEST(size_16)
+		{
+			int x, y;
+			ptr_tag v = { &x, 1 };
+			ncore::atomic::atom<ptr_tag> a(v);
+			CHECK_TRUE(a.load().ptr == &x);
+
+			ptr_tag e = v;
+			ptr_tag n = { &y, 2 };
+			CHECK_TRUE(a.compare_exchange(e, n));
+			CHECK_FALSE(a.compare_exchange(e, n));
+			CHECK_TRUE(e.ptr == &y);
+			CHECK_EQUAL(2, e.tag);
+
+			ptr_tag o = a.exchange(v);
+			CHECK_TRUE(o.ptr == &y);
+			CHECK_TRUE(a.load().ptr == &x);
+		}
+	}
+
+	UNITTEST_FIXTURE(atom_float)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		UNITTEST_TEST(f32)
+		{
+			ncore::atomic::atom_f32 a;
+			CHECK_EQUAL(0.0f, a.load());
+			CHECK_EQUAL(0.0f, a.fetch_add(1.5f));
+			CHECK_EQUAL(1.5f, a.fetch_sub(0.25f));
+			CHECK_EQUAL(1.25f, a.exchange(4.0f));
+			a.add(2.0f);
+			CHECK_EQUAL(6.0f, a.load());
+			a.store(-1.0f);
+			CHECK_EQUAL(-1.0f, a.load());
+		}
+
+		UNITTEST_TEST(f64_min_max)
+		{
+			ncore::atomic::atom_f64 a(2.5);
+			CHECK_EQUAL(2.5, a.fetch_max(1.0));
+			CHECK_EQUAL(2.5, a.fetch_max(3.5));
+			CHECK_EQUAL(3.5, a.fetch_min(-0.5));
+			CHECK_EQUAL(-0.5, a.fetch_min(0.0));
+			CHECK_EQUAL(-0.5, a.load());
+
+			// A NaN argument never compares as smaller or larger
+			volatile double zero = 0.0;
+			double const nan = zero / zero;
+			a.fetch_min(nan);
+			a.fetch_max(nan);
+			CHECK_EQUAL(-0.5, a.load());
+		}
+	}
+
+	UNITTEST_FIXTURE(atom_ptr)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		struct node { node* next; ncore::s32 value; };
+
+		UNITTEST_TEST(load_store)
+		{
+			node a, b;
+			ncore::atomic::atom_ptr<node> p;
+			CHECK_NULL(p.load());
+
+			p.store(&a);
+			CHECK_TRUE(p.load() == &a);
+
+			node* o = p.exchange(&b);
+			CHECK_TRUE(o == &a);
+			CHECK_TRUE(p.load() == &b);
+		}
+
+		UNITTEST_TEST(tag)
+		{
+			node a, b;
+			ncore::atomic::atom_ptr<node> p(&a);
+
+			ncore::u64 t0;
+			CHECK_TRUE(p.load(t0) == &a);
+
+			// A -> B -> A, the pointer matches again but the tag does not
+			CHECK_TRUE(p.cas(&a, t0, &b));
+			ncore::u64 t1;
+			p.load(t1);
+			CHECK_TRUE(p.cas(&b, t1, &a));
+			CHECK_FALSE(p.cas(&a, t0, &b));
+
+			ncore::u64 t2;
+			CHECK_TRUE(p.load(t2) == &a);
+			CHECK_NOT_EQUAL(t0, t2);
+			CHECK_TRUE(p.cas(&a, t2, &b));
+		}
+
+		UNITTEST_TEST(treiber_stack)
+		{
+			node nodes[4];
+			ncore::atomic::atom_ptr<node> head;
+
+			for (ncore::s32 i = 0; i < 4; ++i)
+			{
+				node* n = &nodes[i];
+				n->value = i;
+				ncore::u64 t;
+				do
+				{
+					n->next = head.load(t);
+				} while (!head.cas(n->next, t, n));
+			}
+
+			for (ncore::s32 i = 3; i >= 0; --i)
+			{
+				ncore::u64 t;
+				node* n;
+				do
+				{
+					n = head.load(t);
+				} while (!head.cas(n, t, n->next));
+				CHECK_EQUAL(i, n->value);
+			}
+			CHECK_NULL(head.load());
+		}
+	}
+
+	UNITTEST_FIXTURE(wait_notify)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static void sProducer(ncore::atomic::atom_u32* word)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			word->set(1);
+			word->notify_all();
+		}
+
+		UNITTEST_TEST(no_wait)
+		{
+			ncore::atomic::atom_u32 w(5);
+			w.wait(4);
+			CHECK_TRUE(w.wait_for(4, 1000000));
+		}
+
+		UNITTEST_TEST(timeout)
+		{
+			ncore::atomic::atom_s32 w(-1);
+			CHECK_FALSE(w.wait_for(-1, 1000000));
+			CHECK_EQUAL(-1, w.get());
+		}
+
+		UNITTEST_TEST(wake)
+		{
+			ncore::atomic::atom_u32 w(0);
+			std::thread producer(sProducer, &w);
+			w.wait(0);
+			CHECK_EQUAL(1, w.get());
+			producer.join();
+		}
+
+		UNITTEST_TEST(spin_then_park)
+		{
+			ncore::atomic::atom_u32 w(0);
+			std::thread producer(sProducer, &w);
+			ncore::backoff::spin_then_park<16> park;
+			park.wait(w, (ncore::u32)0);
+			CHECK_EQUAL(1, w.get());
+			producer.join();
+		}
+	}
+
+	UNITTEST_FIXTURE(asymmetric_fence)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sNumRounds = 2000;
+
+		// Dekker: each side publishes its round and then reads the other side's.
+		// With the fences at least one of them must see the other's store.
+		struct dekker
+		{
+			ncore::atomic::atom_u32		start;
+			ncore::atomic::atom_u32		reader;
+			ncore::atomic::atom_u32		writer;
+			ncore::atomic::atom_u32		reader_seen;
+			ncore::atomic::atom_u32		done;
+		};
+
+		static void sReader(dekker* d)
+		{
+			for (ncore::u32 r = 1; r < sNumRounds; ++r)
+			{
+				while (d->start.load_acquire() < r)
+					ncore::barrier::yield();
+				d->reader.store_relaxed(r);
+				ncore::barrier::asymmetric_light();
+				d->reader_seen.store_relaxed(d->writer.load_relaxed());
+				d->done.store_release(r);
+			}
+		}
+
+		UNITTEST_TEST(light_heavy)
+		{
+			dekker d;
+			std::thread reader(sReader, &d);
+
+			ncore::u32 missed = 0;
+			for (ncore::u32 r = 1; r < sNumRounds; ++r)
+			{
+				d.start.store_release(r);
+				d.writer.store_relaxed(r);
+				ncore::barrier::asymmetric_heavy();
+				ncore::u32 const reader_round = d.reader.load_relaxed();
+
+				while (d.done.load_acquire() < r)
+					ncore::barrier::yield();
+				if (reader_round < r && d.reader_seen.load_relaxed() < r)
+					++missed;
+			}
+			reader.join();
+			CHECK_EQUAL(0, missed);
+		}
 	}
 }
 UNITTEST_SUITE_END
@@ -0,0 +1,55 @@
+#ifndef __CMULTICORE_TEST_BENCH_H__
+#define __CMULTICORE_TEST_BENCH_H__
+#include "ccore/c_target.h"
+
+#include <chrono>
+#include <thread>
+#include <stdio.h>
+
+// Scaffolding for the bench_* suites. They only build with D_ATOMIC_BENCH defined,
+// report their timings on the console and only check that the work was done.
+namespace nbench
+{
+	typedef std::chrono::steady_clock::time_point	time_point;
+
+	static const ncore::u32 sMaxThreads = 64;
+
+	inline time_point	sNow()
+	{
+		return std::chrono::steady_clock::now();
+	}
+
+	inline double		sElapsedNs(time_point start)
+	{
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(sNow() - start).count();
+	}
+
+	// Run worker(args...) on 'n' threads at the same time.
+	// @return the wall clock time in nanoseconds from the first start to the last join
+	template <class F, class... A>
+	inline double		sRunThreads(ncore::u32 n, F worker, A... args)
+	{
+		std::thread threads[sMaxThreads];
+		time_point const start = sNow();
+		for (ncore::u32 t = 0; t < n && t < sMaxThreads; ++t)
+			threads[t] = std::thread(worker, args...);
+		for (ncore::u32 t = 0; t < n && t < sMaxThreads; ++t)
+			threads[t].join();
+		return sElapsedNs(start);
+	}
+
+	// Same as sRunThreads(), every thread gets its index as the last argument
+	template <class F, class... A>
+	inline double		sRunThreadsIndexed(ncore::u32 n, F worker, A... args)
+	{
+		std::thread threads[sMaxThreads];
+		time_point const start = sNow();
+		for (ncore::u32 t = 0; t < n && t < sMaxThreads; ++t)
+			threads[t] = std::thread(worker, args..., t);
+		for (ncore::u32 t = 0; t < n && t < sMaxThreads; ++t)
+			threads[t].join();
+		return sElapsedNs(start);
+	}
+}
+
+#endif // __CMULTICORE_TEST_BENCH_H__
@@ -0,0 +1,124 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_lifo.h"
+#include "catomic/c_mempool.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+// The backoff policies under contention, every thread takes an element from a
+// lifo or mempool and puts it back, ns per get+put pair for 1 to sMaxThreads
+// threads. backoff::standard is chosen from these numbers.
+UNITTEST_SUITE_BEGIN(bench_backoff)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sMaxThreads = 16;
+		static const ncore::u32 sNumItems = 64;
+		static const ncore::u32 sNumOps = 1 << 17;
+
+		template <class B>
+		static void sLifo(ncore::atomic::lifo* l, ncore::u32 ops, ncore::atomic::atom_u32* done)
+		{
+			ncore::u32 n = 0;
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				ncore::u32 v;
+				if (l->ipop<B>(v))
+				{
+					l->ipush<B>(v);
+					++n;
+				}
+			}
+			done->add(n);
+		}
+
+		template <class B>
+		static void sMempool(ncore::atomic::mempool* m, ncore::u32 ops, ncore::atomic::atom_u32* done)
+		{
+			ncore::u32 n = 0;
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				ncore::u32 c;
+				if (m->get<B>(c) != NULL)
+				{
+					m->put<B>(c);
+					++n;
+				}
+			}
+			done->add(n);
+		}
+
+		template <class B>
+		static void sRunLifo(const char* name)
+		{
+			for (ncore::u32 n = 1; n <= sMaxThreads; n <<= 1)
+			{
+				ncore::atomic::lifo l;
+				l.init(gAtomicAllocator, sNumItems);
+				l.fill();
+				ncore::atomic::atom_u32 done;
+				ncore::u32 const ops = sNumOps / n;
+				double const ns = nbench::sRunThreads(n, sLifo<B>, &l, ops, &done);
+				printf("lifo %s, %u threads: %.2f ns/op\n", name, n, ns / (n * ops));
+				// Every thread holds at most one element, there are more than enough
+				CHECK_EQUAL(n * ops, done.get());
+				CHECK_EQUAL(sNumItems, l.size());
+				l.clear();
+			}
+		}
+
+		template <class B>
+		static void sRunMempool(const char* name)
+		{
+			for (ncore::u32 n = 1; n <= sMaxThreads; n <<= 1)
+			{
+				ncore::atomic::mempool m;
+				m.init(gAtomicAllocator, 16, sNumItems);
+				ncore::atomic::atom_u32 done;
+				ncore::u32 const ops = sNumOps / n;
+				double const ns = nbench::sRunThreads(n, sMempool<B>, &m, ops, &done);
+				printf("mempool %s, %u threads: %.2f ns/op\n", name, n, ns / (n * ops));
+				CHECK_EQUAL(n * ops, done.get());
+				m.clear();
+			}
+		}
+
+		UNITTEST_TEST(none)
+		{
+			sRunLifo<ncore::backoff::none>("none");
+			sRunMempool<ncore::backoff::none>("none");
+		}
+
+		UNITTEST_TEST(pause)
+		{
+			sRunLifo<ncore::backoff::pause>("pause");
+			sRunMempool<ncore::backoff::pause>("pause");
+		}
+
+		UNITTEST_TEST(exponential)
+		{
+			sRunLifo<ncore::backoff::exponential<> >("exponential");
+			sRunMempool<ncore::backoff::exponential<> >("exponential");
+		}
+
+		UNITTEST_TEST(exponential_yield)
+		{
+			sRunLifo<ncore::backoff::exponential_yield<> >("exponential_yield");
+			sRunMempool<ncore::backoff::exponential_yield<> >("exponential_yield");
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
@@ -0,0 +1,120 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_combiner.h"
+#include "catomic/c_fifo.h"
+#include "catomic/c_lifo.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+// A flat combining min-heap against the lock-free lifo and fifo, every thread
+// takes an item and puts one back, ns per pop+push pair for 1 to sMaxThreads threads.
+UNITTEST_SUITE_BEGIN(bench_combiner)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sMaxThreads = 64;
+		static const ncore::u32 sNumItems = 256;
+		static const ncore::u32 sNumOps = 1 << 16;
+
+		typedef ncore::atomic::combining_heap<ncore::u32, sNumItems, sMaxThreads>	heap_t;
+
+		static void sHeap(heap_t* h, ncore::u32 ops, ncore::atomic::atom_u32* done)
+		{
+			ncore::u32 const tid = h->attach();
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				ncore::u32 v;
+				if (h->pop(tid, v))
+				{
+					h->push(tid, v + sNumItems);
+					done->incr();
+				}
+			}
+			h->detach(tid);
+		}
+
+		static void sLifo(ncore::atomic::lifo* l, ncore::u32 ops, ncore::atomic::atom_u32* done)
+		{
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				ncore::u32 v;
+				if (l->pop(v))
+				{
+					l->push(v);
+					done->incr();
+				}
+			}
+		}
+
+		static void sFifo(ncore::atomic::fifo* f, ncore::u32 ops, ncore::atomic::atom_u32* done)
+		{
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				ncore::u32 v, r;
+				if (f->pop(v, r))
+				{
+					f->push(r);
+					done->incr();
+				}
+			}
+		}
+
+		template <class S>
+		static void sRun(const char* name, void (*worker)(S*, ncore::u32, ncore::atomic::atom_u32*), S* s)
+		{
+			for (ncore::u32 n = 1; n <= sMaxThreads; n <<= 2)
+			{
+				ncore::atomic::atom_u32 done;
+				ncore::u32 const ops = sNumOps / n;
+				double const ns = nbench::sRunThreads(n, worker, s, ops, &done);
+				printf("%s, %u threads: %.2f ns/op\n", name, n, ns / (n * ops));
+				// Items only disappear for the moment between pop and push
+				CHECK_EQUAL(n * ops, done.get());
+			}
+		}
+
+		UNITTEST_TEST(heap)
+		{
+			heap_t h;
+			ncore::u32 const tid = h.attach();
+			for (ncore::u32 i = 0; i < sNumItems; ++i)
+				h.push(tid, i);
+			h.detach(tid);
+			sRun("combining_heap", sHeap, &h);
+			CHECK_EQUAL(sNumItems, h.size());
+		}
+
+		UNITTEST_TEST(lifo)
+		{
+			ncore::atomic::lifo l;
+			l.init(gAtomicAllocator, sNumItems);
+			l.fill();
+			sRun("lifo", sLifo, &l);
+			CHECK_EQUAL(sNumItems, l.size());
+			l.clear();
+		}
+
+		UNITTEST_TEST(fifo)
+		{
+			ncore::atomic::fifo f;
+			f.init(gAtomicAllocator, sNumItems);
+			f.fill();
+			sRun("fifo", sFifo, &f);
+			f.clear();
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
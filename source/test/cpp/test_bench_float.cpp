@@ -0,0 +1,63 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+#include <mutex>
+
+// Accumulating a double from several threads, lock-free atom_f64 against a
+// mutex-protected double, ns per add. The sum is of whole numbers, so it is exact.
+UNITTEST_SUITE_BEGIN(bench_float)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sNumThreads = 4;
+		static const ncore::u32 sNumItems = 1 << 18;
+
+		struct locked_f64
+		{
+			std::mutex		lock;
+			double			value;
+
+			void			add(double v)					{ std::lock_guard<std::mutex> g(lock); value += v; }
+		};
+
+		template <class T>
+		static void sAccumulate(T* sum)
+		{
+			for (ncore::u32 i = 0; i < sNumItems; ++i)
+				sum->add(1.0);
+		}
+
+		template <class T>
+		static double sRun(T* sum)
+		{
+			return nbench::sRunThreads(sNumThreads, sAccumulate<T>, sum) / (sNumThreads * sNumItems);
+		}
+
+		UNITTEST_TEST(atom_f64_vs_mutex)
+		{
+			ncore::atomic::atom_f64 a;
+			double const atom_ns = sRun(&a);
+
+			locked_f64 m;
+			m.value = 0.0;
+			double const mutex_ns = sRun(&m);
+
+			printf("%u threads add: atom_f64 %.2f ns/op, mutex %.2f ns/op\n", sNumThreads, atom_ns, mutex_ns);
+			CHECK_EQUAL((double)(sNumThreads * sNumItems), a.load());
+			CHECK_EQUAL((double)(sNumThreads * sNumItems), m.value);
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
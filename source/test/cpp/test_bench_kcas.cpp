@@ -0,0 +1,103 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_kcas.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+// Updating k words together, lock-free kcas against a test-and-test-and-set
+// spinlock around plain words, ns per update.
+UNITTEST_SUITE_BEGIN(bench_kcas)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::kcas_domain<8, 4>	domain_t;
+
+		static const ncore::u32 sNumThreads = 2;
+		static const ncore::u32 sNumOps = 1 << 16;
+
+		struct locked_words
+		{
+			ncore::atomic::atom_s32		lock;
+			ncore::u64					words[4];
+
+			void		acquire()
+			{
+				ncore::backoff::standard delay;
+				while (lock.load_relaxed() != 0 || !lock.cas_acquire(0, 1))
+					delay.wait();
+			}
+			void		release()									{ lock.store_release(0); }
+		};
+
+		struct kcas_args
+		{
+			domain_t*					domain;
+			ncore::atomic::kcas_word*	words;
+			ncore::u32					k;
+		};
+
+		static void sKcas(kcas_args a)
+		{
+			ncore::u32 const tid = a.domain->attach();
+			domain_t::entry e[4];
+			for (ncore::u32 i = 0; i < sNumOps; )
+			{
+				for (ncore::u32 w = 0; w < a.k; ++w)
+				{
+					e[w].addr = &a.words[w];
+					e[w].expected = a.domain->read(a.words[w], tid);
+					e[w].desired = e[w].expected + 1;
+				}
+				if (a.domain->kcas(tid, e, a.k))
+					++i;
+			}
+			a.domain->detach(tid);
+		}
+
+		static void sLocked(locked_words* l, ncore::u32 k)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				l->acquire();
+				for (ncore::u32 w = 0; w < k; ++w)
+					l->words[w] += 1;
+				l->release();
+			}
+		}
+
+		UNITTEST_TEST(kcas_vs_spinlock)
+		{
+			for (ncore::u32 k = 2; k <= 4; ++k)
+			{
+				domain_t d;
+				ncore::atomic::kcas_word words[4];
+				kcas_args args = { &d, words, k };
+
+				double const kcas_ns = nbench::sRunThreads(sNumThreads, sKcas, args) / (sNumThreads * sNumOps);
+
+				locked_words l;
+				for (ncore::u32 w = 0; w < 4; ++w)
+					l.words[w] = 0;
+				double const lock_ns = nbench::sRunThreads(sNumThreads, sLocked, &l, k) / (sNumThreads * sNumOps);
+
+				printf("k=%u, %u threads: kcas %.2f ns/op, spinlock %.2f ns/op\n", k, sNumThreads, kcas_ns, lock_ns);
+
+				ncore::u32 const tid = d.attach();
+				CHECK_EQUAL(sNumThreads * sNumOps, d.read(words[k - 1], tid));
+				CHECK_EQUAL(sNumThreads * sNumOps, l.words[k - 1]);
+			}
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
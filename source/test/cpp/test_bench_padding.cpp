@@ -0,0 +1,109 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+#include "catomic/c_ring.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+// Producer-consumer benchmarks for the cache line layout of the containers, ns per item.
+// A full or empty ring yields, so the numbers stay meaningful with fewer cores than threads.
+UNITTEST_SUITE_BEGIN(bench_padding)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sNumItems = 1 << 20;
+
+		static void sRingProducer(ncore::atomic::ring<ncore::u32>* r)
+		{
+			for (ncore::u32 i = 1; i <= sNumItems; )
+			{
+				if (r->push(i))
+					++i;
+				else
+					ncore::barrier::yield();
+			}
+		}
+
+		template <class T>
+		static void sIncrement(T* c)
+		{
+			for (ncore::u32 i = 0; i < sNumItems; ++i)
+				c->incr();
+		}
+
+		UNITTEST_TEST(ring_spsc)
+		{
+			ncore::atomic::ring<ncore::u32> r;
+			r.init(gAtomicAllocator, 1024);
+
+			nbench::time_point const start = nbench::sNow();
+			std::thread producer(sRingProducer, &r);
+
+			ncore::u64 sum = 0;
+			ncore::u32 v;
+			for (ncore::u32 n = 0; n < sNumItems; )
+			{
+				if (r.pop(v))
+				{
+					sum += v;
+					++n;
+				}
+				else
+				{
+					ncore::barrier::yield();
+				}
+			}
+			producer.join();
+
+			printf("ring<u32> spsc: %.2f ns/item\n", nbench::sElapsedNs(start) / sNumItems);
+			CHECK_EQUAL((ncore::u64)sNumItems * (sNumItems + 1) / 2, sum);
+			r.clear();
+		}
+
+		UNITTEST_TEST(counters_adjacent_vs_padded)
+		{
+			struct adjacent
+			{
+				ncore::atomic::atom_u64		a;
+				ncore::atomic::atom_u64		b;
+			};
+			struct padded
+			{
+				ncore::atomic::atom_padded<ncore::atomic::atom_u64>	a;
+				ncore::atomic::atom_padded<ncore::atomic::atom_u64>	b;
+			};
+
+			CHECK_EQUAL(0, (ncore::u32)(sizeof(ncore::atomic::atom_padded<ncore::atomic::atom_u64>) % DCORE_CACHELINE_SIZE));
+
+			adjacent c1;
+			nbench::time_point start = nbench::sNow();
+			std::thread t1(sIncrement<ncore::atomic::atom_u64>, &c1.a);
+			sIncrement(&c1.b);
+			t1.join();
+			double const adjacent_ns = nbench::sElapsedNs(start);
+
+			padded c2;
+			start = nbench::sNow();
+			std::thread t2(sIncrement<ncore::atomic::atom_u64>, (ncore::atomic::atom_u64*)&c2.a);
+			sIncrement((ncore::atomic::atom_u64*)&c2.b);
+			t2.join();
+			double const padded_ns = nbench::sElapsedNs(start);
+
+			printf("2 threads incr: adjacent %.2f ns/op, padded %.2f ns/op\n", adjacent_ns / sNumItems, padded_ns / sNumItems);
+			CHECK_EQUAL(sNumItems, c1.a.get());
+			CHECK_EQUAL(sNumItems, c2.b.get());
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
@@ -0,0 +1,226 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_atomic.h"
+#include "catomic/c_barrier.h"
+#include "catomic/c_spinlock.h"
+
+#include "test_bench.h"
+
+#if defined(D_ATOMIC_BENCH)
+
+#include <mutex>
+
+// Ticket, MCS and CLH locks against std::mutex. Throughput runs a short critical
+// section from 1 to sMaxThreads threads, handoff has two threads that take turns
+// so that every acquisition is a transfer from the other thread, ns per
+// acquisition or handoff. The read-heavy test compares rw_spinlock with a single
+// atom_s32 reader count.
+UNITTEST_SUITE_BEGIN(bench_spinlock)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::ticket_lock<>		ticket_t;
+		typedef ncore::atomic::mcs_lock<>			mcs_t;
+		typedef ncore::atomic::clh_lock<8>			clh_t;
+		typedef ncore::atomic::rw_spinlock<>		rw_t;
+
+		static const ncore::u32 sMaxThreads = 4;
+		static const ncore::u32 sNumOps = 1 << 16;
+		static const ncore::u32 sNumHandoffs = 1 << 12;
+		static const ncore::u32 sWriteEvery = 1024;
+
+		// One thread's access to a lock, all locks look the same to the benchmark
+		struct ticket_user
+		{
+			ticket_t&		l;
+							ticket_user(ticket_t& l) : l(l)				{ }
+			void			lock()										{ l.lock(); }
+			void			unlock()									{ l.unlock(); }
+		};
+
+		struct mcs_user
+		{
+			mcs_t&			l;
+			mcs_t::node		n;
+							mcs_user(mcs_t& l) : l(l)					{ }
+			void			lock()										{ l.lock(n); }
+			void			unlock()									{ l.unlock(n); }
+		};
+
+		struct clh_user
+		{
+			clh_t&			l;
+			clh_t::handle	h;
+							clh_user(clh_t& l) : l(l)					{ l.attach(h); }
+							~clh_user()									{ l.detach(h); }
+			void			lock()										{ l.lock(h); }
+			void			unlock()									{ l.unlock(h); }
+		};
+
+		struct mutex_user
+		{
+			std::mutex&		l;
+							mutex_user(std::mutex& l) : l(l)			{ }
+			void			lock()										{ l.lock(); }
+			void			unlock()									{ l.unlock(); }
+		};
+
+		// Reader-writer lock on one word, the count of readers or -1 for a writer
+		struct counted_rw
+		{
+			ncore::atomic::atom_s32		state;
+
+			ncore::u32		read_lock()
+			{
+				ncore::backoff::exponential_yield<> delay;
+				for (;;)
+				{
+					ncore::s32 const s = state.load_relaxed();
+					if (s >= 0 && state.cas_acquire(s, s + 1))
+						return 0;
+					delay.wait();
+				}
+			}
+			void			read_unlock(ncore::u32)						{ state.decr(); }
+			void			write_lock()
+			{
+				ncore::backoff::exponential_yield<> delay;
+				while (state.load_relaxed() != 0 || !state.cas_acquire(0, -1))
+					delay.wait();
+			}
+			void			write_unlock()								{ state.store_release(0); }
+		};
+
+		struct shared
+		{
+			ncore::u64					count;
+			ncore::atomic::atom_u32		turn;
+		};
+
+		template <class U, class L>
+		static void sThroughput(L* l, shared* s, ncore::u32 ops)
+		{
+			U u(*l);
+			for (ncore::u32 i = 0; i < ops; ++i)
+			{
+				u.lock();
+				s->count += 1;
+				u.unlock();
+			}
+		}
+
+		// Waits for its turn, then hands the turn to the other thread under the lock
+		template <class U, class L>
+		static void sHandoff(L* l, shared* s, ncore::u32 me)
+		{
+			U u(*l);
+			for (ncore::u32 i = 0; i < sNumHandoffs; ++i)
+			{
+				ncore::backoff::exponential_yield<> delay;
+				while (s->turn.load_acquire() != me)
+					delay.wait();
+				u.lock();
+				s->turn.store_release(me ^ 1);
+				s->count += 1;
+				u.unlock();
+			}
+		}
+
+		// Mostly reads, one write every sWriteEvery operations
+		template <class L>
+		static void sReadMostly(L* l, shared* s, ncore::u32 ops)
+		{
+			ncore::u64 sum = 0;
+			for (ncore::u32 i = 1; i <= ops; ++i)
+			{
+				if ((i % sWriteEvery) == 0)
+				{
+					l->write_lock();
+					s->count += 1;
+					l->write_unlock();
+				}
+				else
+				{
+					ncore::u32 const token = l->read_lock();
+					sum += s->count;
+					l->read_unlock(token);
+				}
+			}
+			s->turn.add((ncore::u32)sum & 1);
+		}
+
+		template <class L>
+		static void sRunReadMostly(const char* name)
+		{
+			for (ncore::u32 n = 1; n <= sMaxThreads; n <<= 1)
+			{
+				L l;
+				shared s;
+				s.count = 0;
+				s.turn.store_relaxed(0);
+				ncore::u32 const ops = sNumOps / n;
+				double const ns = nbench::sRunThreads(n, sReadMostly<L>, &l, &s, ops);
+				printf("%s, %u threads: %.2f ns/op\n", name, n, ns / (n * ops));
+				CHECK_EQUAL((ncore::u64)n * (ops / sWriteEvery), s.count);
+			}
+		}
+
+		template <class U, class L>
+		static void sRun(const char* name)
+		{
+			for (ncore::u32 n = 1; n <= sMaxThreads; n <<= 1)
+			{
+				L l;
+				shared s;
+				s.count = 0;
+				s.turn.store_relaxed(0);
+				ncore::u32 const ops = sNumOps / n;
+				double const ns = nbench::sRunThreads(n, sThroughput<U, L>, &l, &s, ops);
+				printf("%s, %u threads: %.2f ns/lock\n", name, n, ns / (n * ops));
+				CHECK_EQUAL((ncore::u64)n * ops, s.count);
+			}
+
+			L l;
+			shared s;
+			s.count = 0;
+			s.turn.store_relaxed(0);
+			double const ns = nbench::sRunThreadsIndexed(2, sHandoff<U, L>, &l, &s);
+			printf("%s, handoff: %.2f ns\n", name, ns / (2 * sNumHandoffs));
+			CHECK_EQUAL((ncore::u64)2 * sNumHandoffs, s.count);
+		}
+
+		UNITTEST_TEST(ticket)
+		{
+			sRun<ticket_user, ticket_t>("ticket_lock");
+		}
+
+		UNITTEST_TEST(mcs)
+		{
+			sRun<mcs_user, mcs_t>("mcs_lock");
+		}
+
+		UNITTEST_TEST(clh)
+		{
+			sRun<clh_user, clh_t>("clh_lock");
+		}
+
+		UNITTEST_TEST(mutex)
+		{
+			sRun<mutex_user, std::mutex>("std::mutex");
+		}
+
+		UNITTEST_TEST(read_mostly)
+		{
+			sRunReadMostly<rw_t>("rw_spinlock");
+			sRunReadMostly<counted_rw>("atom_s32 rw");
+		}
+	}
+}
+UNITTEST_SUITE_END
+
+#endif // D_ATOMIC_BENCH
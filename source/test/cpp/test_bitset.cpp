@@ -0,0 +1,92 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_bitset.h"
+
+#include <thread>
+
+UNITTEST_SUITE_BEGIN(bitset)
+{
+	UNITTEST_FIXTURE(atomic_bitset)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::atomic_bitset<200>	bitset_t;
+
+		static void sAcquireRelease(bitset_t* b, ncore::u32 hint)
+		{
+			for (ncore::s32 n = 0; n < 10000; ++n)
+			{
+				ncore::u32 i = 0;
+				if (b->acquire_any(i, hint))
+					b->release(i);
+			}
+		}
+
+		UNITTEST_TEST(construct)
+		{
+			bitset_t b;
+			CHECK_EQUAL(200, b.max_size());
+			CHECK_EQUAL(0, b.count());
+			CHECK_FALSE(b.test(0));
+			CHECK_FALSE(b.test(199));
+		}
+
+		UNITTEST_TEST(acquire_all)
+		{
+			bitset_t b;
+			ncore::u32 i;
+			for (ncore::u32 n = 0; n < 200; ++n)
+			{
+				CHECK_TRUE(b.acquire_any(i, 0));
+				CHECK_EQUAL(n, i);
+			}
+			CHECK_EQUAL(200, b.count());
+			CHECK_FALSE(b.acquire_any(i, 0));
+			CHECK_FALSE(b.acquire_any(i, 3));
+
+			b.release(130);
+			CHECK_EQUAL(199, b.count());
+			CHECK_TRUE(b.acquire_any(i, 1));
+			CHECK_EQUAL(130, i);
+		}
+
+		UNITTEST_TEST(hint)
+		{
+			// The hint only moves the start of the search, an empty bitset always has room
+			bitset_t b;
+			ncore::u32 i = 0;
+			CHECK_TRUE(b.acquire_any(i, 0));
+			CHECK_EQUAL(0, i);
+			CHECK_TRUE(b.acquire_any(i));
+			CHECK_TRUE(b.test(i));
+			b.release(i);
+			b.release(0);
+			CHECK_EQUAL(0, b.count());
+		}
+
+		UNITTEST_TEST(acquire_release)
+		{
+			bitset_t b;
+			CHECK_TRUE(b.acquire(5));
+			CHECK_FALSE(b.acquire(5));
+			CHECK_TRUE(b.test(5));
+			b.release(5);
+			CHECK_FALSE(b.test(5));
+		}
+
+		UNITTEST_TEST(threads)
+		{
+			bitset_t b;
+			std::thread t1(sAcquireRelease, &b, 1);
+			std::thread t2(sAcquireRelease, &b, 2);
+			sAcquireRelease(&b, 0);
+			t1.join();
+			t2.join();
+			CHECK_EQUAL(0, b.count());
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,157 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_combiner.h"
+
+#include <thread>
+
+UNITTEST_SUITE_BEGIN(combiner)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::combining_heap<ncore::u32, 1024, 8>	heap_t;
+
+		static const ncore::u32 sNumThreads = 8;
+		static const ncore::u32 sNumItems = 100;
+		static const ncore::u32 sNumOps = 10000;
+
+		// Sequential structure that records the order requests were applied in
+		struct counter
+		{
+			struct request		{ ncore::u32 add; };
+			struct response		{ ncore::u64 before; };
+
+			ncore::u64			value;
+
+			counter() : value(0) {}
+
+			void		execute(request const& req, response& res)
+			{
+				res.before = value;
+				value += req.add;
+			}
+		};
+
+		static void sAdd(ncore::atomic::flat_combiner<counter, 8>* fc, ncore::u64* total)
+		{
+			ncore::u32 const tid = fc->attach();
+			counter::request req = { 1 };
+			counter::response res;
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				fc->execute(tid, req, res);
+				*total += res.before;
+			}
+			fc->detach(tid);
+		}
+
+		// Pushes its own range of values
+		static void sPush(heap_t* h, ncore::u32 first)
+		{
+			ncore::u32 const tid = h->attach();
+			for (ncore::u32 i = 0; i < sNumItems; ++i)
+				h->push(tid, first + i);
+			h->detach(tid);
+		}
+
+		// Pushes and pops, the heap never runs dry
+		static void sPushPop(heap_t* h, ncore::u32 seed)
+		{
+			ncore::u32 const tid = h->attach();
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				h->push(tid, (seed >> 8) & 0xffff);
+				ncore::u32 v;
+				h->pop(tid, v);
+			}
+			h->detach(tid);
+		}
+
+		UNITTEST_TEST(sequential_heap)
+		{
+			ncore::atomic::sequential_heap<ncore::s32, 8> h;
+			ncore::s32 const values[] = { 5, -1, 7, 3, 3, 9, 0, 2 };
+			for (ncore::u32 i = 0; i < 8; ++i)
+				CHECK_TRUE(h.push(values[i]));
+			CHECK_FALSE(h.push(1));
+			CHECK_EQUAL(8, h.size());
+
+			ncore::s32 const sorted[] = { -1, 0, 2, 3, 3, 5, 7, 9 };
+			ncore::s32 v;
+			for (ncore::u32 i = 0; i < 8; ++i)
+			{
+				CHECK_TRUE(h.pop(v));
+				CHECK_EQUAL(sorted[i], v);
+			}
+			CHECK_FALSE(h.pop(v));
+		}
+
+		UNITTEST_TEST(attach)
+		{
+			ncore::atomic::flat_combiner<counter, 2> fc;
+			ncore::u32 const a = fc.attach();
+			ncore::u32 const b = fc.attach();
+			CHECK_TRUE(a < 2 && b < 2 && a != b);
+			CHECK_EQUAL(2, fc.attach());
+			fc.detach(a);
+			CHECK_EQUAL(a, fc.attach());
+		}
+
+		UNITTEST_TEST(every_request_once)
+		{
+			// Each request sees a distinct value, so the 'before' values sum to 0+1+..+n-1
+			ncore::atomic::flat_combiner<counter, 8> fc;
+			ncore::u64 totals[sNumThreads];
+			std::thread threads[sNumThreads];
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+			{
+				totals[t] = 0;
+				threads[t] = std::thread(sAdd, &fc, &totals[t]);
+			}
+			ncore::u64 sum = 0;
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+			{
+				threads[t].join();
+				sum += totals[t];
+			}
+			ncore::u64 const n = (ncore::u64)sNumThreads * sNumOps;
+			CHECK_EQUAL(n, fc.data().value);
+			CHECK_EQUAL(n * (n - 1) / 2, sum);
+		}
+
+		UNITTEST_TEST(heap_threads)
+		{
+			heap_t h;
+			std::thread threads[sNumThreads];
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t] = std::thread(sPush, &h, t * sNumItems);
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+			CHECK_EQUAL(sNumThreads * sNumItems, h.size());
+
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t] = std::thread(sPushPop, &h, t);
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+			CHECK_EQUAL(sNumThreads * sNumItems, h.size());
+
+			ncore::u32 const tid = h.attach();
+			ncore::u32 prev = 0;
+			ncore::u32 v;
+			for (ncore::u32 i = 0; i < sNumThreads * sNumItems; ++i)
+			{
+				CHECK_TRUE(h.pop(tid, v));
+				CHECK_TRUE(prev <= v);
+				prev = v;
+			}
+			CHECK_FALSE(h.pop(tid, v));
+			h.detach(tid);
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,63 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_counter.h"
+
+#include <thread>
+
+UNITTEST_SUITE_BEGIN(counter)
+{
+	UNITTEST_FIXTURE(striped_counter)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::striped_counter<16>	counter_t;
+
+		static void sCount(counter_t* c)
+		{
+			for (ncore::s32 i = 0; i < 100000; ++i)
+				c->incr();
+		}
+
+		UNITTEST_TEST(construct)
+		{
+			counter_t c;
+			CHECK_EQUAL(0, c.read());
+		}
+
+		UNITTEST_TEST(add_sub)
+		{
+			counter_t c;
+			c.incr();
+			c.incr();
+			c.add(10);
+			c.decr();
+			c.sub(3);
+			CHECK_EQUAL(8, c.read());
+
+			c.reset();
+			CHECK_EQUAL(0, c.read());
+		}
+
+		UNITTEST_TEST(layout)
+		{
+			CHECK_EQUAL(16 * DCORE_CACHELINE_SIZE, (ncore::s32)sizeof(counter_t));
+		}
+
+		UNITTEST_TEST(threads)
+		{
+			counter_t c;
+			std::thread t1(sCount, &c);
+			std::thread t2(sCount, &c);
+			std::thread t3(sCount, &c);
+			sCount(&c);
+			t1.join();
+			t2.join();
+			t3.join();
+			CHECK_EQUAL(400000, c.read());
+		}
+	}
+}
+UNITTEST_SUITE_END
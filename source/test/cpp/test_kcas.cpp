@@ -0,0 +1,139 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_kcas.h"
+
+#include <thread>
+
+UNITTEST_SUITE_BEGIN(kcas)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::kcas_domain<8, 4>	domain_t;
+		typedef domain_t::entry						entry_t;
+
+		static const ncore::u32 sNumWords = 4;
+		static const ncore::u32 sNumOps = 20000;
+
+		// Move one unit between two words, the sum of all words never changes
+		static void sTransfer(domain_t* d, ncore::atomic::kcas_word* words, ncore::u32 seed)
+		{
+			ncore::u32 const tid = d->attach();
+			for (ncore::u32 i = 0; i < sNumOps; )
+			{
+				seed = seed * 1103515245 + 12345;
+				ncore::u32 const from = (seed >> 8) % sNumWords;
+				ncore::u32 const to = (from + 1 + ((seed >> 16) % (sNumWords - 1))) % sNumWords;
+
+				entry_t e[2];
+				e[0].addr = &words[from];
+				e[0].expected = d->read(words[from], tid);
+				e[1].addr = &words[to];
+				e[1].expected = d->read(words[to], tid);
+				if (e[0].expected == 0)
+					continue;
+				e[0].desired = e[0].expected - 1;
+				e[1].desired = e[1].expected + 1;
+				if (d->kcas(tid, e, 2))
+					++i;
+			}
+			d->detach(tid);
+		}
+
+		// Increment all words in one kcas, they are always equal
+		static void sIncrement(domain_t* d, ncore::atomic::kcas_word* words)
+		{
+			ncore::u32 const tid = d->attach();
+			for (ncore::u32 i = 0; i < sNumOps; )
+			{
+				entry_t e[3];
+				for (ncore::u32 w = 0; w < 3; ++w)
+				{
+					e[w].addr = &words[w];
+					e[w].expected = d->read(words[w], tid);
+					e[w].desired = e[w].expected + 1;
+				}
+				if (d->kcas(tid, e, 3))
+					++i;
+			}
+			d->detach(tid);
+		}
+
+		UNITTEST_TEST(success_failure)
+		{
+			domain_t d;
+			ncore::u32 const tid = d.attach();
+			CHECK_TRUE(tid < 8);
+
+			ncore::atomic::kcas_word a(1), b(2), c(3);
+			entry_t e[3] = { { &c, 3, 30 }, { &a, 1, 10 }, { &b, 2, 20 } };
+			CHECK_TRUE(d.kcas(tid, e, 3));
+			CHECK_EQUAL(10, d.read(a, tid));
+			CHECK_EQUAL(20, d.read(b, tid));
+			CHECK_EQUAL(30, d.read(c, tid));
+
+			// One stale expected value fails the whole operation
+			entry_t f[2] = { { &a, 10, 11 }, { &b, 2, 21 } };
+			CHECK_FALSE(d.kcas(tid, f, 2));
+			CHECK_EQUAL(10, d.read(a, tid));
+			CHECK_EQUAL(20, d.read(b, tid));
+
+			entry_t g[1] = { { &a, 10, ncore::atomic::kcas_word::VALUE_MAX } };
+			CHECK_TRUE(d.kcas(tid, g, 1));
+			CHECK_EQUAL(ncore::atomic::kcas_word::VALUE_MAX, d.read(a, tid));
+			d.detach(tid);
+		}
+
+		UNITTEST_TEST(attach_detach)
+		{
+			domain_t d;
+			ncore::u32 tids[8];
+			for (ncore::u32 i = 0; i < 8; ++i)
+				tids[i] = d.attach();
+			CHECK_EQUAL(8, d.attach());
+			d.detach(tids[3]);
+			CHECK_EQUAL(tids[3], d.attach());
+		}
+
+		UNITTEST_TEST(threads_transfer)
+		{
+			domain_t d;
+			ncore::atomic::kcas_word words[sNumWords] = { 100, 100, 100, 100 };
+
+			std::thread t1(sTransfer, &d, words, 1);
+			std::thread t2(sTransfer, &d, words, 2);
+			std::thread t3(sTransfer, &d, words, 3);
+			sTransfer(&d, words, 4);
+			t1.join();
+			t2.join();
+			t3.join();
+
+			ncore::u32 const tid = d.attach();
+			ncore::u64 sum = 0;
+			for (ncore::u32 w = 0; w < sNumWords; ++w)
+				sum += d.read(words[w], tid);
+			CHECK_EQUAL(100 * sNumWords, sum);
+		}
+
+		UNITTEST_TEST(threads_increment)
+		{
+			domain_t d;
+			ncore::atomic::kcas_word words[3];
+			std::thread t1(sIncrement, &d, words);
+			std::thread t2(sIncrement, &d, words);
+			sIncrement(&d, words);
+			t1.join();
+			t2.join();
+
+			ncore::u32 const tid = d.attach();
+			CHECK_EQUAL(3 * sNumOps, d.read(words[0], tid));
+			CHECK_EQUAL(3 * sNumOps, d.read(words[1], tid));
+			CHECK_EQUAL(3 * sNumOps, d.read(words[2], tid));
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -128,6 +128,64 @@ UNITTEST_SUITE_BEGIN(lifo)
 			CHECK_TRUE(f.push(2));
 			CHECK_TRUE(f.push(3));
 		}
+
+		UNITTEST_TEST(push_pop_backoff)
+		{
+			ncore::atomic::lifo f;
+			f.init(gAtomicAllocator, 4);
+
+			ncore::u32 i;
+			CHECK_TRUE(f.ipush<ncore::backoff::none>(0));
+			CHECK_TRUE(f.ipush<ncore::backoff::pause>(1));
+			CHECK_TRUE(f.ipush<ncore::backoff::exponential<16> >(2));
+			CHECK_TRUE(f.ipush<ncore::backoff::exponential_yield<16> >(3));
+			CHECK_FALSE(f.ipush<ncore::backoff::none>(3));
+
+			CHECK_TRUE(f.ipop<ncore::backoff::exponential_yield<16> >(i));
+			CHECK_EQUAL(3, i);
+			CHECK_TRUE(f.ipop<ncore::backoff::exponential<16> >(i));
+			CHECK_EQUAL(2, i);
+			CHECK_TRUE(f.ipop<ncore::backoff::pause>(i));
+			CHECK_EQUAL(1, i);
+			CHECK_TRUE(f.ipop<ncore::backoff::none>(i));
+			CHECK_EQUAL(0, i);
+			CHECK_FALSE(f.ipop<ncore::backoff::none>(i));
+		}
+
+		UNITTEST_TEST(backoff_policies)
+		{
+			ncore::backoff::exponential<8> e;
+			CHECK_EQUAL(1, e._spins);
+			e.wait();
+			e.wait();
+			CHECK_EQUAL(4, e._spins);
+			e.wait();
+			e.wait();
+			e.wait();
+			CHECK_EQUAL(8, e._spins);
+
+			ncore::backoff::exponential_yield<4> y;
+			y.wait();
+			y.wait();
+			y.wait();
+			y.wait();
+			CHECK_EQUAL(4, y._spins);
+
+			// A MAX that is not a power of two is not overshot
+			ncore::backoff::exponential<6> c;
+			c.wait();
+			c.wait();
+			c.wait();
+			CHECK_EQUAL(6, c._spins);
+			c.wait();
+			CHECK_EQUAL(6, c._spins);
+
+			ncore::backoff::exponential_yield<6> cy;
+			cy.wait();
+			cy.wait();
+			cy.wait();
+			CHECK_EQUAL(6, cy._spins);
+		}
 	}
 }
 UNITTEST_SUITE_END
@@ -17,6 +17,23 @@ UNITTEST_SUITE_DECLARE(cUnitTest, ring);
 UNITTEST_SUITE_DECLARE(cUnitTest, shadow);
 UNITTEST_SUITE_DECLARE(cUnitTest, mempool);
 UNITTEST_SUITE_DECLARE(cUnitTest, mbufpool);
+UNITTEST_SUITE_DECLARE(cUnitTest, counter);
+UNITTEST_SUITE_DECLARE(cUnitTest, bitset);
+UNITTEST_SUITE_DECLARE(cUnitTest, kcas);
+UNITTEST_SUITE_DECLARE(cUnitTest, percpu);
+UNITTEST_SUITE_DECLARE(cUnitTest, topology);
+UNITTEST_SUITE_DECLARE(cUnitTest, spinlock);
+UNITTEST_SUITE_DECLARE(cUnitTest, mutex);
+UNITTEST_SUITE_DECLARE(cUnitTest, sync);
+UNITTEST_SUITE_DECLARE(cUnitTest, combiner);
+#if defined(D_ATOMIC_BENCH)
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_padding);
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_float);
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_kcas);
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_spinlock);
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_combiner);
+UNITTEST_SUITE_DECLARE(cUnitTest, bench_backoff);
+#endif
 
 namespace ncore
 {
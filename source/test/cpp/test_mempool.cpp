@@ -171,6 +171,30 @@ UNITTEST_SUITE_BEGIN(mempool)
 				CHECK_EQUAL(chunk[i], mp.i2c(i));
 			}
 		}
+
+		UNITTEST_TEST(high_water)
+		{
+			mempool mp;
+			CHECK_TRUE(mp.init(gAtomicAllocator, 16, 8));
+			mp.track_high_water(true);
+
+			xbyte* a = mp.get();
+			xbyte* b = mp.get();
+			mp.put(a);
+			xbyte* c = mp.get();
+			CHECK_EQUAL(2, mp.high_water());
+
+			ncore::u32 i = 0;
+			CHECK_NOT_NULL(mp.get<ncore::backoff::none>(i));
+			CHECK_EQUAL(3, mp.high_water());
+
+			mp.put(b);
+			mp.put(c);
+			mp.put(i);
+			CHECK_EQUAL(3, mp.high_water());
+			mp.reset_high_water();
+			CHECK_EQUAL(0, mp.high_water());
+		}
 	}
 }
 UNITTEST_SUITE_END
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_mutex.h"
+#include "catomic/c_ring.h"
+
+#include <thread>
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+UNITTEST_SUITE_BEGIN(mutex)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sNumThreads = 4;
+		static const ncore::u32 sNumOps = 20000;
+		static const ncore::u32 sNumItems = 10000;
+
+		struct shared
+		{
+			ncore::atomic::mutex		m;
+			ncore::u32					count;
+
+			shared() : count(0) {}
+		};
+
+		static void sIncrement(shared* s)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				ncore::atomic::mutex::guard g(s->m);
+				s->count += 1;
+				// Now and then hold the lock across a yield so that others have to sleep
+				if ((i & 1023) == 0)
+					ncore::barrier::yield();
+			}
+		}
+
+		// Blocking ring: consumers sleep on 'not_empty' while the ring is empty
+		struct blocking_ring
+		{
+			ncore::atomic::ring<ncore::u32>	items;
+			ncore::atomic::mutex			m;
+			ncore::atomic::condvar			not_empty;
+		};
+
+		static void sProducer(blocking_ring* r)
+		{
+			for (ncore::u32 i = 1; i <= sNumItems; )
+			{
+				ncore::atomic::mutex::guard g(r->m);
+				if (r->items.push(i))
+				{
+					++i;
+					r->not_empty.notify_one();
+				}
+				else
+				{
+					ncore::barrier::yield();
+				}
+			}
+		}
+
+		UNITTEST_TEST(lock_unlock)
+		{
+			ncore::atomic::mutex m;
+			CHECK_FALSE(m.is_locked());
+			m.lock();
+			CHECK_TRUE(m.is_locked());
+			CHECK_FALSE(m.try_lock());
+			m.unlock();
+			CHECK_TRUE(m.try_lock());
+			m.unlock();
+			{
+				ncore::atomic::mutex::guard g(m);
+				CHECK_TRUE(m.is_locked());
+			}
+			CHECK_FALSE(m.is_locked());
+		}
+
+		UNITTEST_TEST(threads)
+		{
+			shared s;
+			std::thread threads[sNumThreads];
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t] = std::thread(sIncrement, &s);
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+			CHECK_EQUAL(sNumThreads * sNumOps, s.count);
+			CHECK_FALSE(s.m.is_locked());
+		}
+
+		UNITTEST_TEST(condvar_timeout)
+		{
+			ncore::atomic::mutex m;
+			ncore::atomic::condvar cv;
+			ncore::atomic::mutex::guard g(m);
+			CHECK_FALSE(cv.wait_for(m, 1000000));
+			CHECK_TRUE(m.is_locked());
+
+			// Nobody waits, notify does not block or leave anything behind
+			cv.notify_one();
+			cv.notify_all();
+			CHECK_FALSE(cv.wait_for(m, 1000000));
+		}
+
+		UNITTEST_TEST(condvar_ring)
+		{
+			blocking_ring r;
+			r.items.init(gAtomicAllocator, 16);
+			std::thread producer(sProducer, &r);
+
+			ncore::u64 sum = 0;
+			for (ncore::u32 n = 0; n < sNumItems; ++n)
+			{
+				ncore::atomic::mutex::guard g(r.m);
+				ncore::u32 v;
+				while (!r.items.pop(v))
+					r.not_empty.wait(r.m);
+				sum += v;
+			}
+			producer.join();
+
+			CHECK_EQUAL((ncore::u64)sNumItems * (sNumItems + 1) / 2, sum);
+			r.items.clear();
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -0,0 +1,209 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_percpu.h"
+
+#include <thread>
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+UNITTEST_SUITE_BEGIN(percpu)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static const ncore::u32 sNumOps = 100000;
+		static const ncore::u32 sNumNodes = 64;
+
+		// The slots are over-aligned, they come from the allocator with cache line
+		// alignment rather than from operator new
+		struct counters
+		{
+			typedef ncore::atomic::atom_padded<ncore::atomic::atom_s64>	slot_t;
+
+			slot_t*			slots;
+			ncore::u32		count;
+
+			counters() : count(ncore::atomic::percpu_slots())
+			{
+				slots = (slot_t*)gAtomicAllocator->allocate(count * sizeof(slot_t), DCORE_CACHELINE_SIZE);
+				for (ncore::u32 i = 0; i < count; ++i)
+					slots[i].store_relaxed(0);
+			}
+			~counters() { gAtomicAllocator->deallocate(slots); }
+
+			ncore::atomic::atom_s64* slot(ncore::u32 cpu) { return &slots[cpu % count]; }
+		};
+
+		struct lists
+		{
+			typedef ncore::atomic::atom_padded<ncore::atomic::percpu_list>	head_t;
+
+			head_t*			heads;
+			ncore::u32		count;
+
+			lists() : count(ncore::atomic::percpu_slots())
+			{
+				heads = (head_t*)gAtomicAllocator->allocate(count * sizeof(head_t), DCORE_CACHELINE_SIZE);
+				for (ncore::u32 i = 0; i < count; ++i)
+				{
+					heads[i].head = NULL;
+					heads[i].lock.clear();
+				}
+			}
+			~lists() { gAtomicAllocator->deallocate(heads); }
+
+			ncore::atomic::percpu_list* list(ncore::u32 cpu) { return &heads[cpu % count]; }
+		};
+
+		static void sAdd(counters* c)
+		{
+			ncore::atomic::percpu_register_thread();
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				ncore::u32 cpu;
+				do
+				{
+					cpu = ncore::atomic::percpu_cpu();
+				} while (ncore::atomic::percpu_add(cpu, c->slot(cpu), 1) == ncore::atomic::percpu_restart);
+			}
+			ncore::atomic::percpu_unregister_thread();
+		}
+
+		// Pop a node from the list of the current cpu, NULL when that one is empty
+		static ncore::atomic::percpu_node* sPopAny(lists* l)
+		{
+			for (;;)
+			{
+				ncore::u32 const cpu = ncore::atomic::percpu_cpu();
+				ncore::atomic::percpu_node* n;
+				ncore::s32 const r = ncore::atomic::percpu_pop(cpu, l->list(cpu), n);
+				if (r == ncore::atomic::percpu_ok)
+					return n;
+				if (r == ncore::atomic::percpu_fail)
+					return NULL;
+			}
+		}
+
+		static void sPushPop(lists* l, ncore::atomic::percpu_node* nodes)
+		{
+			for (ncore::u32 i = 0; i < sNumNodes; ++i)
+			{
+				ncore::u32 cpu;
+				do
+				{
+					cpu = ncore::atomic::percpu_cpu();
+				} while (ncore::atomic::percpu_push(cpu, l->list(cpu), &nodes[i]) == ncore::atomic::percpu_restart);
+			}
+			for (ncore::u32 round = 0; round < 1000; ++round)
+			{
+				ncore::atomic::percpu_node* n = sPopAny(l);
+				if (n == NULL)
+					continue;
+				ncore::u32 cpu;
+				do
+				{
+					cpu = ncore::atomic::percpu_cpu();
+				} while (ncore::atomic::percpu_push(cpu, l->list(cpu), n) == ncore::atomic::percpu_restart);
+			}
+		}
+
+		UNITTEST_TEST(cpu)
+		{
+			bool const registered = ncore::atomic::percpu_register_thread();
+			CHECK_EQUAL(registered, ncore::atomic::percpu_rseq());
+			if (registered)
+				CHECK_TRUE(ncore::atomic::percpu_cpu() < ncore::atomic::cpu_current::sCount());
+			CHECK_TRUE(ncore::atomic::percpu_cpu() < ncore::atomic::percpu_slots());
+		}
+
+		UNITTEST_TEST(cmpxchg)
+		{
+			counters c;
+			ncore::s32 r;
+			do
+			{
+				ncore::u32 const cpu = ncore::atomic::percpu_cpu();
+				r = ncore::atomic::percpu_cmpxchg(cpu, c.slot(cpu), 1, 2);
+			} while (r == ncore::atomic::percpu_restart);
+			CHECK_EQUAL(ncore::atomic::percpu_fail, r);
+
+			ncore::u32 cpu;
+			do
+			{
+				cpu = ncore::atomic::percpu_cpu();
+				r = ncore::atomic::percpu_cmpxchg(cpu, c.slot(cpu), 0, 5);
+			} while (r == ncore::atomic::percpu_restart);
+			CHECK_EQUAL(ncore::atomic::percpu_ok, r);
+			CHECK_EQUAL(5, c.slot(cpu)->get());
+		}
+
+		UNITTEST_TEST(threads_add)
+		{
+			counters c;
+			std::thread t1(sAdd, &c);
+			std::thread t2(sAdd, &c);
+			std::thread t3(sAdd, &c);
+			sAdd(&c);
+			t1.join();
+			t2.join();
+			t3.join();
+
+			ncore::s64 sum = 0;
+			for (ncore::u32 i = 0; i < c.count; ++i)
+				sum += c.slots[i].get();
+			CHECK_EQUAL(4 * sNumOps, sum);
+		}
+
+		UNITTEST_TEST(list)
+		{
+			lists l;
+			ncore::atomic::percpu_node nodes[2];
+			ncore::u32 const cpu = 0;
+			ncore::atomic::percpu_list* list = l.list(cpu);
+
+			// Run on the list directly, a restart only means we are on another cpu
+			if (ncore::atomic::percpu_push(cpu, list, &nodes[0]) == ncore::atomic::percpu_ok)
+			{
+				CHECK_EQUAL(&nodes[0], list->head);
+				CHECK_EQUAL((ncore::atomic::percpu_node*)NULL, nodes[0].next);
+			}
+			list->head = &nodes[1];
+			nodes[1].next = &nodes[0];
+			nodes[0].next = NULL;
+
+			ncore::atomic::percpu_node* n;
+			ncore::s32 r = ncore::atomic::percpu_pop(cpu, list, n);
+			if (r != ncore::atomic::percpu_restart)
+			{
+				CHECK_EQUAL(ncore::atomic::percpu_ok, r);
+				CHECK_EQUAL(&nodes[1], n);
+				CHECK_EQUAL(&nodes[0], list->head);
+			}
+		}
+
+		UNITTEST_TEST(threads_list)
+		{
+			lists l;
+			ncore::atomic::percpu_node nodes[4][sNumNodes];
+			std::thread t1(sPushPop, &l, nodes[0]);
+			std::thread t2(sPushPop, &l, nodes[1]);
+			std::thread t3(sPushPop, &l, nodes[2]);
+			sPushPop(&l, nodes[3]);
+			t1.join();
+			t2.join();
+			t3.join();
+
+			// Every node ends up in exactly one list
+			ncore::u32 count = 0;
+			for (ncore::u32 i = 0; i < l.count; ++i)
+				for (ncore::atomic::percpu_node* n = l.heads[i].head; n != NULL; n = n->next)
+					++count;
+			CHECK_EQUAL(4 * sNumNodes, count);
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -456,6 +456,41 @@ UNITTEST_SUITE_BEGIN(queue)
 				CHECK_EQUAL(f.max_size(), f.size() + f.room());
 			}
 		}
+
+		UNITTEST_TEST(push_pop_backoff)
+		{
+			ncore::atomic::queue<ncore::s32, ncore::backoff::exponential_yield<64> > f;
+			f.init(gAtomicAllocator, 4);
+			CHECK_TRUE(f.valid());
+
+			CHECK_TRUE(f.push(10));
+			CHECK_TRUE(f.push(20));
+
+			ncore::s32 v;
+			CHECK_TRUE(f.pop(v));
+			CHECK_EQUAL(10, v);
+			CHECK_TRUE(f.pop(v));
+			CHECK_EQUAL(20, v);
+			CHECK_FALSE(f.pop(v));
+		}
+
+		UNITTEST_TEST(high_water)
+		{
+			ncore::atomic::queue<ncore::s32> f;
+			f.init(gAtomicAllocator, 8);
+			f.track_high_water(true);
+
+			ncore::s32 v;
+			CHECK_TRUE(f.push(1));
+			CHECK_TRUE(f.push(2));
+			CHECK_TRUE(f.pop(v));
+			CHECK_TRUE(f.push(3));
+			CHECK_TRUE(f.push(4));
+			CHECK_EQUAL(3, f.high_water());
+
+			while (f.pop(v)) {}
+			CHECK_EQUAL(3, f.high_water());
+		}
 	}
 }
 UNITTEST_SUITE_END
@@ -303,6 +303,31 @@ UNITTEST_SUITE_BEGIN(ring)
 
 			_ring_data.release();
 		}
+
+		UNITTEST_TEST(high_water)
+		{
+			ncore::atomic::ring<ncore::s32> f;
+			f.init(gAtomicAllocator, 8);
+			f.track_high_water(true);
+			CHECK_EQUAL(0, f.high_water());
+
+			ncore::s32 v;
+			CHECK_TRUE(f.push(1));
+			CHECK_TRUE(f.push(2));
+			CHECK_TRUE(f.push(3));
+			CHECK_TRUE(f.pop(v));
+			CHECK_TRUE(f.pop(v));
+			CHECK_TRUE(f.push(4));
+			CHECK_EQUAL(3, f.high_water());
+
+			ncore::s32* p = f.push_begin();
+			f.push_commit(p);
+			f.push_commit(f.push_begin());
+			CHECK_EQUAL(4, f.high_water());
+
+			f.reset_high_water();
+			CHECK_EQUAL(0, f.high_water());
+		}
 	}
 }
 UNITTEST_SUITE_END
@@ -0,0 +1,246 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_spinlock.h"
+
+#include <thread>
+
+UNITTEST_SUITE_BEGIN(spinlock)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::ticket_lock<>		ticket_t;
+		typedef ncore::atomic::mcs_lock<>			mcs_t;
+		typedef ncore::atomic::clh_lock<4>			clh_t;
+		typedef ncore::atomic::rw_spinlock<8, 16>	rw_t;
+
+		static const ncore::u32 sNumThreads = 4;
+		static const ncore::u32 sNumOps = 20000;
+
+		// Plain data behind the lock, 'inside' catches two holders at the same time
+		struct shared
+		{
+			ncore::u32					count;
+			ncore::atomic::atom_u32		inside;
+			ncore::atomic::atom_u32		overlaps;
+
+			shared() : count(0) {}
+
+			void		update()
+			{
+				if (inside.exchange(1) != 0)
+					overlaps.incr();
+				count += 1;
+				inside.store_release(0);
+			}
+		};
+
+		static void sTicket(ticket_t* l, shared* s)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				ticket_t::guard g(*l);
+				s->update();
+			}
+		}
+
+		static void sMcs(mcs_t* l, shared* s)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				mcs_t::guard g(*l);
+				s->update();
+			}
+		}
+
+		static void sClh(clh_t* l, shared* s)
+		{
+			clh_t::handle h;
+			if (!l->attach(h))
+				return;
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				clh_t::guard g(*l, h);
+				s->update();
+			}
+			l->detach(h);
+		}
+
+		// Writers keep both words equal, readers must never see them differ
+		struct rw_shared
+		{
+			ncore::u32					a;
+			ncore::u32					b;
+			ncore::atomic::atom_u32		torn;
+
+			rw_shared() : a(0), b(0) {}
+		};
+
+		static void sRwReader(rw_t* l, rw_shared* s)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				rw_t::read_guard g(*l);
+				if (s->a != s->b)
+					s->torn.incr();
+			}
+		}
+
+		static void sRwWriter(rw_t* l, rw_shared* s)
+		{
+			for (ncore::u32 i = 0; i < sNumOps / 16; ++i)
+			{
+				rw_t::write_guard g(*l);
+				s->a += 1;
+				s->b += 1;
+			}
+		}
+
+		template <class L>
+		static void sRun(void (*worker)(L*, shared*), L* l, shared* s)
+		{
+			std::thread threads[sNumThreads];
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t] = std::thread(worker, l, s);
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+		}
+
+		UNITTEST_TEST(ticket)
+		{
+			ticket_t l;
+			CHECK_FALSE(l.is_locked());
+			CHECK_TRUE(l.try_lock());
+			CHECK_TRUE(l.is_locked());
+			CHECK_FALSE(l.try_lock());
+			l.unlock();
+			CHECK_FALSE(l.is_locked());
+			{
+				ticket_t::guard g(l);
+				CHECK_TRUE(l.is_locked());
+			}
+			CHECK_FALSE(l.is_locked());
+		}
+
+		UNITTEST_TEST(ticket_threads)
+		{
+			ticket_t l;
+			shared s;
+			sRun(sTicket, &l, &s);
+			CHECK_EQUAL(sNumThreads * sNumOps, s.count);
+			CHECK_EQUAL(0, s.overlaps.get());
+			CHECK_FALSE(l.is_locked());
+		}
+
+		UNITTEST_TEST(mcs)
+		{
+			mcs_t l;
+			mcs_t::node a, b;
+			CHECK_FALSE(l.is_locked());
+			CHECK_TRUE(l.try_lock(a));
+			CHECK_FALSE(l.try_lock(b));
+			l.unlock(a);
+			CHECK_FALSE(l.is_locked());
+			l.lock(b);
+			CHECK_TRUE(l.is_locked());
+			l.unlock(b);
+			{
+				mcs_t::guard g(l);
+				CHECK_TRUE(l.is_locked());
+			}
+			CHECK_FALSE(l.is_locked());
+		}
+
+		UNITTEST_TEST(mcs_threads)
+		{
+			mcs_t l;
+			shared s;
+			sRun(sMcs, &l, &s);
+			CHECK_EQUAL(sNumThreads * sNumOps, s.count);
+			CHECK_EQUAL(0, s.overlaps.get());
+			CHECK_FALSE(l.is_locked());
+		}
+
+		UNITTEST_TEST(clh)
+		{
+			clh_t l;
+			clh_t::handle h[5];
+			for (ncore::u32 i = 0; i < 4; ++i)
+				CHECK_TRUE(l.attach(h[i]));
+			CHECK_FALSE(l.attach(h[4]));
+
+			// Nodes move between the handles, every handle keeps working
+			for (ncore::u32 n = 0; n < 3; ++n)
+			{
+				for (ncore::u32 i = 0; i < 4; ++i)
+				{
+					CHECK_FALSE(l.is_locked());
+					clh_t::guard g(l, h[i]);
+					CHECK_TRUE(l.is_locked());
+				}
+			}
+			for (ncore::u32 i = 0; i < 4; ++i)
+				l.detach(h[i]);
+			CHECK_TRUE(l.attach(h[4]));
+			l.detach(h[4]);
+		}
+
+		UNITTEST_TEST(clh_threads)
+		{
+			clh_t l;
+			shared s;
+			sRun(sClh, &l, &s);
+			CHECK_EQUAL(sNumThreads * sNumOps, s.count);
+			CHECK_EQUAL(0, s.overlaps.get());
+			CHECK_FALSE(l.is_locked());
+		}
+
+		UNITTEST_TEST(rw)
+		{
+			rw_t l;
+			CHECK_TRUE(l.is_read_biased());
+			ncore::u32 const t1 = l.read_lock();
+			ncore::u32 const t2 = l.read_lock();
+			l.read_unlock(t2);
+			l.read_unlock(t1);
+
+			// A writer revokes the bias, it comes back after 16 slow readers
+			l.write_lock();
+			CHECK_FALSE(l.is_read_biased());
+			l.write_unlock();
+			for (ncore::u32 i = 0; i < 15; ++i)
+			{
+				rw_t::read_guard g(l);
+				CHECK_FALSE(l.is_read_biased());
+			}
+			{
+				rw_t::read_guard g(l);
+			}
+			CHECK_TRUE(l.is_read_biased());
+			{
+				rw_t::write_guard g(l);
+				CHECK_FALSE(l.is_read_biased());
+			}
+		}
+
+		UNITTEST_TEST(rw_threads)
+		{
+			rw_t l;
+			rw_shared s;
+			std::thread threads[sNumThreads];
+			threads[0] = std::thread(sRwWriter, &l, &s);
+			for (ncore::u32 t = 1; t < sNumThreads; ++t)
+				threads[t] = std::thread(sRwReader, &l, &s);
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+			CHECK_EQUAL(sNumOps / 16, s.a);
+			CHECK_EQUAL(s.a, s.b);
+			CHECK_EQUAL(0, s.torn.get());
+		}
+	}
+}
+UNITTEST_SUITE_END
@@ -311,6 +311,35 @@ UNITTEST_SUITE_BEGIN(stack)
 
 			_stack_data.release();
 		}
+
+		UNITTEST_TEST(push_pop_backoff)
+		{
+			ncore::atomic::stack<ncore::s32, ncore::backoff::none> f;
+			f.init(gAtomicAllocator, 4);
+			CHECK_TRUE(f.valid());
+
+			CHECK_TRUE(f.push(10));
+			CHECK_TRUE(f.push(20));
+
+			ncore::s32* p = f.push_begin();
+			CHECK_NOT_NULL(p);
+			*p = 30;
+			f.push_commit(p);
+
+			ncore::s32 v;
+			CHECK_TRUE(f.pop(v));
+			CHECK_EQUAL(30, v);
+
+			p = f.pop_begin();
+			CHECK_NOT_NULL(p);
+			CHECK_EQUAL(20, *p);
+			f.pop_finish(p);
+
+			CHECK_TRUE(f.pop(v));
+			CHECK_EQUAL(10, v);
+			CHECK_TRUE(f.empty());
+			f.clear();
+		}
 	}
 }
 UNITTEST_SUITE_END
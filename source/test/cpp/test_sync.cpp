@@ -0,0 +1,152 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_sync.h"
+
+#include <thread>
+
+extern ncore::alloc_t* gAtomicAllocator;
+
+UNITTEST_SUITE_BEGIN(sync)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		typedef ncore::atomic::latch<>				latch_t;
+		typedef ncore::atomic::cyclic_barrier<4>	barrier_t;
+		typedef ncore::atomic::semaphore<>			semaphore_t;
+
+		static const ncore::u32 sNumThreads = 8;
+		static const ncore::u32 sMaxParties = 64;
+		static const ncore::u32 sNumPhases = 200;
+		static const ncore::u32 sNumOps = 10000;
+
+		static void sLatchWorker(latch_t* start, latch_t* done, ncore::atomic::atom_u32* count)
+		{
+			start->wait();
+			count->incr();
+			done->count_down();
+		}
+
+		// Every thread writes its slot of the phase, after the barrier all slots
+		// of that phase must be written
+		struct phases
+		{
+			barrier_t					b;
+			ncore::u32					slots[sMaxParties];
+			ncore::atomic::atom_u32		errors;
+			ncore::atomic::atom_u32		completed;
+		};
+
+		static void sBarrierWorker(phases* p, ncore::u32 id, ncore::u32 parties)
+		{
+			for (ncore::u32 phase = 1; phase <= sNumPhases; ++phase)
+			{
+				p->slots[id] = phase;
+				if (p->b.arrive_and_wait(id))
+					p->completed.incr();
+				for (ncore::u32 i = 0; i < parties; ++i)
+				{
+					if (p->slots[i] < phase)
+						p->errors.incr();
+				}
+				// Nobody writes the next phase before everyone checked this one
+				p->b.arrive_and_wait(id);
+			}
+		}
+
+		struct limited
+		{
+			semaphore_t					sem;
+			ncore::atomic::atom_u32		inside;
+			ncore::atomic::atom_u32		max_inside;
+
+			limited() : sem(2) {}
+		};
+
+		static void sSemaphoreWorker(limited* l)
+		{
+			for (ncore::u32 i = 0; i < sNumOps; ++i)
+			{
+				l->sem.acquire();
+				l->max_inside.fetch_max(l->inside.fetch_add(1) + 1);
+				if ((i & 255) == 0)
+					ncore::barrier::yield();
+				l->inside.decr();
+				l->sem.release();
+			}
+		}
+
+		UNITTEST_TEST(latch)
+		{
+			latch_t start(1);
+			latch_t done(sNumThreads);
+			ncore::atomic::atom_u32 count;
+			CHECK_FALSE(start.try_wait());
+
+			std::thread threads[sNumThreads];
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t] = std::thread(sLatchWorker, &start, &done, &count);
+			ncore::barrier::yield();
+			CHECK_EQUAL(0, count.get());
+			start.count_down();
+			done.wait();
+			CHECK_EQUAL(sNumThreads, count.get());
+			CHECK_TRUE(done.try_wait());
+			for (ncore::u32 t = 0; t < sNumThreads; ++t)
+				threads[t].join();
+		}
+
+		UNITTEST_TEST(cyclic_barrier)
+		{
+			// 1 is a lone root, 5 a partial leaf, 8 two levels, 64 three levels
+			ncore::u32 const parties[] = { 1, 5, 8, 64 };
+			for (ncore::u32 n = 0; n < 4; ++n)
+			{
+				phases p;
+				CHECK_TRUE(p.b.init(gAtomicAllocator, parties[n]));
+				CHECK_EQUAL(parties[n], p.b.parties());
+				for (ncore::u32 i = 0; i < sMaxParties; ++i)
+					p.slots[i] = 0;
+
+				std::thread threads[sMaxParties];
+				for (ncore::u32 t = 0; t < parties[n]; ++t)
+					threads[t] = std::thread(sBarrierWorker, &p, t, parties[n]);
+				for (ncore::u32 t = 0; t < parties[n]; ++t)
+					threads[t].join();
+
+				CHECK_EQUAL(0, p.errors.get());
+				CHECK_EQUAL(sNumPhases, p.completed.get());
+				p.b.clear();
+			}
+		}
+
+		UNITTEST_TEST(semaphore)
+		{
+			semaphore_t s(1);
+			CHECK_TRUE(s.try_acquire());
+			CHECK_FALSE(s.try_acquire());
+			s.release(2);
+			CHECK_EQUAL(2, s.count());
+			s.acquire();
+			s.acquire();
+			CHECK_EQUAL(0, s.count());
+		}
+
+		UNITTEST_TEST(semaphore_threads)
+		{
+			limited l;
+			std::thread threads[4];
+			for (ncore::u32 t = 0; t < 4; ++t)
+				threads[t] = std::thread(sSemaphoreWorker, &l);
+			for (ncore::u32 t = 0; t < 4; ++t)
+				threads[t].join();
+			CHECK_TRUE(l.max_inside.get() <= 2);
+			CHECK_EQUAL(2, l.sem.count());
+		}
+	}
+}
+UNITTEST_SUITE_END
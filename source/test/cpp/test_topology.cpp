@@ -0,0 +1,92 @@
+#include "ccore/c_allocator.h"
+
+#include "cunittest/cunittest.h"
+
+#include "catomic/c_topology.h"
+
+#include <thread>
+#include <vector>
+
+UNITTEST_SUITE_BEGIN(topology)
+{
+	UNITTEST_FIXTURE(main)
+	{
+		UNITTEST_FIXTURE_SETUP() {}
+		UNITTEST_FIXTURE_TEARDOWN() {}
+
+		static void sCurrent(ncore::u32* cpu)
+		{
+			*cpu = ncore::atomic::current_cpu();
+		}
+
+		UNITTEST_TEST(groups)
+		{
+			ncore::atomic::topology const& t = ncore::atomic::topology::sGet();
+			CHECK_TRUE(&t == &ncore::atomic::topology::sGet());
+			CHECK_TRUE(t.num_cpus() >= 1);
+			CHECK_TRUE(t.num_nodes() >= 1);
+			CHECK_TRUE(t.num_nodes() <= t.num_cpus());
+
+			for (ncore::u32 l = 0; l < ncore::atomic::topology::LEVEL_COUNT; ++l)
+			{
+				CHECK_TRUE(t.num_groups(l) >= 1);
+				CHECK_TRUE(t.num_groups(l) <= t.num_cpus());
+
+				// Groups are numbered in the order of their lowest cpu
+				ncore::u32 next = 0;
+				for (ncore::u32 c = 0; c < t.num_cpus(); ++c)
+				{
+					ncore::u32 const g = t.group(c, l);
+					CHECK_TRUE(g <= next);
+					if (g == next)
+						++next;
+				}
+				CHECK_EQUAL(t.num_groups(l), next);
+			}
+		}
+
+		UNITTEST_TEST(distance)
+		{
+			ncore::atomic::topology const& t = ncore::atomic::topology::sGet();
+			for (ncore::u32 a = 0; a < t.num_cpus(); ++a)
+			{
+				CHECK_EQUAL((ncore::u32)ncore::atomic::topology::DISTANCE_CPU, t.distance(a, a));
+				for (ncore::u32 b = 0; b < t.num_cpus(); ++b)
+				{
+					CHECK_EQUAL(t.distance(a, b), t.distance(b, a));
+					if (t.node(a) != t.node(b))
+						CHECK_EQUAL((ncore::u32)ncore::atomic::topology::DISTANCE_REMOTE, t.distance(a, b));
+				}
+			}
+		}
+
+		UNITTEST_TEST(neighbours)
+		{
+			ncore::atomic::topology const& t = ncore::atomic::topology::sGet();
+			std::vector<ncore::u32> cpus(t.num_cpus());
+			ncore::u32 const n = t.neighbours(0, cpus.data(), (ncore::u32)cpus.size());
+			CHECK_EQUAL(t.num_cpus() - 1, n);
+			for (ncore::u32 i = 0; i < n; ++i)
+			{
+				CHECK_TRUE(cpus[i] != 0);
+				if (i > 0)
+					CHECK_TRUE(t.distance(0, cpus[i - 1]) <= t.distance(0, cpus[i]));
+			}
+			if (n > 1)
+				CHECK_EQUAL(1, t.neighbours(0, cpus.data(), 1));
+		}
+
+		UNITTEST_TEST(current_cpu)
+		{
+			ncore::atomic::topology const& t = ncore::atomic::topology::sGet();
+			CHECK_TRUE(ncore::atomic::current_cpu() < t.num_cpus());
+			CHECK_TRUE(t.current_group(ncore::atomic::topology::LEVEL_L3) < t.num_groups(ncore::atomic::topology::LEVEL_L3));
+
+			ncore::u32 cpu = 0xffffffff;
+			std::thread other(sCurrent, &cpu);
+			other.join();
+			CHECK_TRUE(cpu < t.num_cpus());
+		}
+	}
+}
+UNITTEST_SUITE_END